@@ -80,11 +80,22 @@ namespace itk {
             img->TransformIndexToPhysicalPoint( idx, o );
             img->SetOrigin( o );
 
+            // Need to shift the buffered region along with the
+            // largest, as only a part of the image may be buffered
+            typename TImageType::RegionType b = img->GetBufferedRegion();
+            typename TImageType::IndexType bIdx = b.GetIndex();
+            for( unsigned int j = 0; j < TImageType::ImageDimension; ++j )
+              {
+              bIdx[j] -= idx[j];
+              }
+            b.SetIndex( bIdx );
+
             idx.Fill( 0 );
             r.SetIndex( idx );
 
-            // Need to set the buffered region to match largest
-            img->SetRegions( r );
+            img->SetLargestPossibleRegion( r );
+            img->SetBufferedRegion( b );
+            img->SetRequestedRegion( b );
 
             return;
             }
@@ -37,6 +37,7 @@
 #include "sitkDetail.h"
 #include "sitkVersion.h"
 #include "sitkImage.h"
+#include "sitkImageBufferAllocator.h"
 #include "sitkTransform.h"
 #include "sitkBSplineTransform.h"
 #include "sitkDisplacementFieldTransform.h"
@@ -48,6 +48,20 @@ namespace simple
   // idiom.
   class PimpleImageBase;
 
+  /** \brief How the pixel buffer of a newly allocated image is initialized
+   *
+   * With sitkZeroInitialized, the default, every pixel is zero. Large
+   * buffers are obtained as zeroed pages from the operating system
+   * instead of being written with zeros, so pages which are never
+   * accessed are not committed to memory. With sitkUninitialized the
+   * pixel values are undefined, which is suitable for a buffer that
+   * is completely overwritten.
+   */
+  enum BufferInitializationEnum {
+    sitkZeroInitialized,
+    sitkUninitialized
+  };
+
   /** \class Image
    * \brief The main Image class for SimpleITK
    */
@@ -82,7 +96,8 @@ namespace simple
      */
     Image( unsigned int width, unsigned int height, PixelIDValueEnum valueEnum  );
     Image( unsigned int width, unsigned int height, unsigned int depth, PixelIDValueEnum valueEnum );
-    Image( const std::vector< unsigned int > &size, PixelIDValueEnum valueEnum, unsigned int numberOfComponents = 0 );
+    Image( const std::vector< unsigned int > &size, PixelIDValueEnum valueEnum, unsigned int numberOfComponents = 0,
+           BufferInitializationEnum bufferInitialization = sitkZeroInitialized );
     /**@}*/
 
 
@@ -202,6 +217,20 @@ namespace simple
     unsigned int GetWidth( void ) const;
     unsigned int GetDepth( void ) const;
 
+    /** \brief Get the region of the image held in memory
+     *
+     * An image which is read or computed in slabs has only a part of
+     * its logical extent, given by GetSize, in memory. This buffered
+     * region starts at the BufferedIndex and has the BufferedSize. The
+     * image's buffer and the pixel access methods are limited to the
+     * buffered region. For a fully buffered image the BufferedIndex
+     * is zero and the BufferedSize is equal to the Size.
+     * @{
+     */
+    std::vector< unsigned int > GetBufferedIndex( void ) const;
+    std::vector< unsigned int > GetBufferedSize( void ) const;
+    /** @} */
+
 
     /** \brief Copy common meta-data from an image to this one.
      *
@@ -349,6 +378,9 @@ namespace simple
      * buffer[c + numComponents*(x+xSize*(y+ySize*z))]
      * \endcode
      *
+     * For an image which is not fully buffered the buffer holds only
+     * the buffered region, and the sizes are those of the BufferedSize.
+     *
      * The pointer to the buffer is not referenced
      * counted. Additionally, while this image is made unique before
      * returnign the pointer, additional copying and usage may
@@ -384,6 +416,46 @@ namespace simple
     const double   *GetBufferAsDouble( ) const;
     /** @} */
 
+    /** \brief Copy a region of the image to or from a buffer
+     *
+     * The region starts at index and has size pixels along each
+     * dimension, it must be inside the buffered region of the
+     * image. The buffer holds the number of components*Xsize*Ysize
+     * and then Zsize values of the region, in the same order as the
+     * image buffer. Unlike accessing each pixel with GetPixelAs and
+     * SetPixelAs, the pixel type is dispatched once and the region is
+     * copied a line at a time.
+     *
+     * The correct method for the current pixel type of the image must
+     * be called or else an exception will be generated. For vector
+     * pixel types the type of the component of the vector must be called.
+     *
+     * \sa Image::GetBufferAsInt8
+     * @{
+     */
+    void GetRegionAsInt8( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, int8_t *buffer ) const;
+    void GetRegionAsUInt8( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, uint8_t *buffer ) const;
+    void GetRegionAsInt16( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, int16_t *buffer ) const;
+    void GetRegionAsUInt16( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, uint16_t *buffer ) const;
+    void GetRegionAsInt32( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, int32_t *buffer ) const;
+    void GetRegionAsUInt32( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, uint32_t *buffer ) const;
+    void GetRegionAsInt64( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, int64_t *buffer ) const;
+    void GetRegionAsUInt64( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, uint64_t *buffer ) const;
+    void GetRegionAsFloat( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, float *buffer ) const;
+    void GetRegionAsDouble( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, double *buffer ) const;
+
+    void SetRegionAsInt8( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, const int8_t *buffer );
+    void SetRegionAsUInt8( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, const uint8_t *buffer );
+    void SetRegionAsInt16( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, const int16_t *buffer );
+    void SetRegionAsUInt16( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, const uint16_t *buffer );
+    void SetRegionAsInt32( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, const int32_t *buffer );
+    void SetRegionAsUInt32( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, const uint32_t *buffer );
+    void SetRegionAsInt64( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, const int64_t *buffer );
+    void SetRegionAsUInt64( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, const uint64_t *buffer );
+    void SetRegionAsFloat( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, const float *buffer );
+    void SetRegionAsDouble( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, const double *buffer );
+    /** @} */
+
 
     /** \brief Performs actually coping if needed to make object unique.
      *
@@ -401,7 +473,8 @@ namespace simple
      * This method internally utlizes the member function factory to
      * dispatch to methods instantiated on the image of the pixel ID
      */
-    void Allocate ( unsigned int width, unsigned int height, unsigned int depth, unsigned int dim4, PixelIDValueEnum valueEnum, unsigned int numberOfComponents );
+    void Allocate ( unsigned int width, unsigned int height, unsigned int depth, unsigned int dim4, PixelIDValueEnum valueEnum, unsigned int numberOfComponents,
+                    BufferInitializationEnum bufferInitialization = sitkZeroInitialized );
 
     /** \brief Dispatched methods for allocating images
      *
@@ -412,15 +485,15 @@ namespace simple
      */
     template<class TImageType>
     typename EnableIf<IsBasic<TImageType>::Value>::Type
-    AllocateInternal ( unsigned int width, unsigned int height, unsigned int depth, unsigned int dim4, unsigned int numberOfComponents );
+    AllocateInternal ( unsigned int width, unsigned int height, unsigned int depth, unsigned int dim4, unsigned int numberOfComponents, BufferInitializationEnum bufferInitialization );
 
     template<class TImageType>
     typename EnableIf<IsVector<TImageType>::Value>::Type
-    AllocateInternal ( unsigned int width, unsigned int height, unsigned int depth, unsigned int dim4, unsigned int numberOfComponents );
+    AllocateInternal ( unsigned int width, unsigned int height, unsigned int depth, unsigned int dim4, unsigned int numberOfComponents, BufferInitializationEnum bufferInitialization );
 
     template<class TImageType>
     typename EnableIf<IsLabel<TImageType>::Value>::Type
-    AllocateInternal ( unsigned int width, unsigned int height, unsigned int depth, unsigned int dim4, unsigned int numberOfComponents );
+    AllocateInternal ( unsigned int width, unsigned int height, unsigned int depth, unsigned int dim4, unsigned int numberOfComponents, BufferInitializationEnum bufferInitialization );
     /**@}*/
 
 
@@ -0,0 +1,217 @@
+/*=========================================================================
+*
+*  Copyright Insight Software Consortium
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*         http://www.apache.org/licenses/LICENSE-2.0.txt
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*
+*=========================================================================*/
+#ifndef sitkImageBufferAllocator_h
+#define sitkImageBufferAllocator_h
+
+#include "sitkCommon.h"
+#include "sitkNonCopyable.h"
+
+#include <map>
+#include <vector>
+
+namespace itk {
+
+#ifndef SWIG
+class SimpleFastMutexLock;
+#endif
+
+namespace simple {
+
+/** \class ImageBufferAllocator
+ * \brief Provides the memory for the pixel buffers of images
+ *
+ * The pixel buffers allocated by Image::Allocate, and by the filters
+ * whose outputs become Images, are obtained from the allocator
+ * returned by ImageBufferAllocator::GetAllocator. That is the
+ * allocator set for the calling thread, else the global allocator,
+ * else the default allocator which uses malloc and calloc.
+ *
+ * A buffer is returned to the allocator it was obtained from when the
+ * last image referencing it is destroyed. An allocator must therefore
+ * remain valid until all buffers allocated with it have been
+ * released.
+ */
+class SITKCommon_EXPORT ImageBufferAllocator
+  : protected NonCopyable
+{
+public:
+
+  virtual ~ImageBufferAllocator( void );
+
+  /** Allocate a buffer of size bytes suitably aligned for any pixel
+   * type. If zeroInitialize is true, the buffer must be filled with
+   * zeros. Returns NULL if the memory can not be allocated. */
+  virtual void *Allocate( size_t size, bool zeroInitialize ) = 0;
+
+  /** Release a buffer previously obtained with Allocate of size bytes */
+  virtual void Deallocate( void *buffer, size_t size ) = 0;
+
+  /** \brief Set the allocator used by all threads without an
+   * allocator of their own.
+   *
+   * NULL restores the default allocator. The global allocator should
+   * be set before images are created by other threads.
+   */
+  static void SetGlobalAllocator( ImageBufferAllocator *allocator );
+  static ImageBufferAllocator *GetGlobalAllocator( void );
+
+  /** \brief Set the allocator used by the calling thread
+   *
+   * NULL restores the global allocator for the calling thread.
+   */
+  static void SetThreadAllocator( ImageBufferAllocator *allocator );
+  static ImageBufferAllocator *GetThreadAllocator( void );
+
+  /** The allocator currently used by the calling thread */
+  static ImageBufferAllocator *GetAllocator( void );
+
+  /** The allocator based on malloc and calloc used when no other
+   * allocator is set */
+  static ImageBufferAllocator *GetDefaultAllocator( void );
+
+protected:
+
+  ImageBufferAllocator( void ) {}
+
+};
+
+
+#ifndef SWIG
+/** \class ImageBufferOwner
+ * \brief Implemented by pixel containers whose buffer is released to
+ * an ImageBufferAllocator
+ *
+ * Code handing a buffer from one container to another uses it to
+ * check that both containers release the buffer the same way.
+ */
+class SITKCommon_EXPORT ImageBufferOwner
+{
+public:
+  virtual ~ImageBufferOwner( void ) {}
+
+  /** The allocator the buffer is released to */
+  virtual ImageBufferAllocator *GetAllocator( void ) const = 0;
+
+  /** Whether two pixel containers release their buffers the same
+   * way, that is both to the same ImageBufferAllocator or both with
+   * delete[] */
+  template< typename TContainer1, typename TContainer2 >
+  static bool IsSameOwner( const TContainer1 *container1, const TContainer2 *container2 )
+    {
+      const ImageBufferOwner *owner1 = dynamic_cast<const ImageBufferOwner *>( container1 );
+      const ImageBufferOwner *owner2 = dynamic_cast<const ImageBufferOwner *>( container2 );
+      if ( owner1 == SITK_NULLPTR || owner2 == SITK_NULLPTR )
+        {
+        return owner1 == owner2;
+        }
+      return owner1->GetAllocator() == owner2->GetAllocator();
+    }
+};
+#endif
+
+
+/** \class AlignedImageBufferAllocator
+ * \brief Allocates buffers aligned to a large boundary
+ *
+ * With the default alignment of 2 MiB, buffers start on a huge page
+ * boundary. On Linux the kernel is additionally advised to back such
+ * buffers with transparent huge pages, which reduces the number of
+ * page faults and TLB misses when large images are traversed.
+ *
+ * Every buffer is a separate mapping from the operating system, so
+ * this allocator is intended for large images, possibly combined
+ * with an ImageBufferPool.
+ */
+class SITKCommon_EXPORT AlignedImageBufferAllocator
+  : public ImageBufferAllocator
+{
+public:
+
+  static const size_t HugePageAlignment = 2 * 1024 * 1024;
+
+  /** The alignment must be a power of two */
+  explicit AlignedImageBufferAllocator( size_t alignment = HugePageAlignment );
+
+  virtual void *Allocate( size_t size, bool zeroInitialize );
+  virtual void Deallocate( void *buffer, size_t size );
+
+  size_t GetAlignment( void ) const { return this->m_Alignment; }
+
+private:
+
+  size_t m_Alignment;
+};
+
+
+/** \class ImageBufferPool
+ * \brief Reuses released buffers for later allocations of similar size
+ *
+ * Requested sizes are rounded up to a bucket, and released buffers
+ * are kept per bucket, so that repeatedly creating and destroying
+ * images of the same size does not go to the heap or the operating
+ * system each time. Buffers are obtained from a source allocator,
+ * the default allocator unless specified.
+ *
+ * When the released buffers kept exceed the maximum cached size,
+ * further released buffers are returned to the source allocator. The
+ * pool may be used from multiple threads.
+ */
+class SITKCommon_EXPORT ImageBufferPool
+  : public ImageBufferAllocator
+{
+public:
+
+  explicit ImageBufferPool( size_t maximumCachedSize = 1024 * 1024 * 1024,
+                            ImageBufferAllocator *source = SITK_NULLPTR );
+
+  /** Releases the cached buffers. Buffers still referenced by images
+   * must not be released to the pool after it is destroyed. */
+  virtual ~ImageBufferPool( void );
+
+  virtual void *Allocate( size_t size, bool zeroInitialize );
+  virtual void Deallocate( void *buffer, size_t size );
+
+  /** Set/Get the maximum number of bytes kept in released buffers */
+  void SetMaximumCachedSize( size_t size );
+  size_t GetMaximumCachedSize( void ) const;
+
+  /** The number of bytes currently kept in released buffers */
+  size_t GetCachedSize( void ) const;
+
+  /** Return all cached buffers to the source allocator */
+  void ReleaseCachedBuffers( void );
+
+  /** The size allocated from the source for a request of size bytes */
+  static size_t GetBucketSize( size_t size );
+
+private:
+
+  typedef std::map< size_t, std::vector< void * > > BucketMapType;
+
+  ImageBufferAllocator *m_Source;
+  size_t                m_MaximumCachedSize;
+  size_t                m_CachedSize;
+  BucketMapType         m_Buckets;
+
+  itk::SimpleFastMutexLock *m_Mutex;
+};
+
+}
+}
+
+#endif // sitkImageBufferAllocator_h
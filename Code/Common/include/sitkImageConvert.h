@@ -18,6 +18,9 @@
 #ifndef sitkImageConvert_h
 #define sitkImageConvert_h
 
+#include "sitkImageBufferAllocator.h"
+
+#include <algorithm>
 
 namespace itk
 {
@@ -28,6 +31,20 @@ namespace simple
 {
 
 
+/** \brief Whether the buffer of one pixel container can be handed to another
+ *
+ * The buffer is only handed over when the source container owns it
+ * and both containers release it the same way, that is both to the
+ * same ImageBufferAllocator or both with delete[].
+ */
+template< typename TFromContainer, typename TToContainer >
+SITKCommon_HIDDEN
+bool CanTransferImageBuffer( const TFromContainer *from, const TToContainer *to )
+{
+  return from->GetContainerManageMemory() && ImageBufferOwner::IsSameOwner( from, to );
+}
+
+
 /** \brief A utility method to help convert between itk image types efficiently.
  *
  */
@@ -48,19 +65,27 @@ GetImageFromVectorImage( itk::VectorImage< TPixelType, ImageDimension > *img, bo
   size_t numberOfElements = img->GetBufferedRegion().GetNumberOfPixels();
   typename ImageType::PixelType* buffer = reinterpret_cast<typename ImageType::PixelType*>( img->GetPixelContainer()->GetBufferPointer() );
 
-  if (!img->GetPixelContainer()->GetContainerManageMemory())
-    {
-    transferOwnership=false;
-    }
-
   typename ImageType::Pointer out = ImageType::New();
 
   out->CopyInformation( img );
   out->SetRegions( img->GetBufferedRegion() );
 
-  // Set the image's pixel container to import the pointer provided.
-  out->GetPixelContainer()->SetImportPointer(buffer, numberOfElements, transferOwnership );
-  img->GetPixelContainer()->SetContainerManageMemory(!transferOwnership);
+  if ( !transferOwnership )
+    {
+    // The output references the buffer, which remains owned by the input.
+    out->GetPixelContainer()->SetImportPointer(buffer, numberOfElements, false );
+    }
+  else if ( CanTransferImageBuffer( img->GetPixelContainer(), out->GetPixelContainer() ) )
+    {
+    // Set the image's pixel container to import the pointer provided.
+    out->GetPixelContainer()->SetImportPointer(buffer, numberOfElements, true );
+    img->GetPixelContainer()->ContainerManageMemoryOff();
+    }
+  else
+    {
+    out->Allocate();
+    std::copy( buffer, buffer + numberOfElements, out->GetBufferPointer() );
+    }
 
   return out;
 
@@ -80,23 +105,32 @@ GetVectorImageFromImage( itk::Image< itk::Vector< TPixelType, NLength >, NImageD
   // Unlike an image of Vectors a VectorImage's container is a
   // container of TPixelType, whos size is the image's number of
   // pixels * number of pixels per component
-  numberOfElements *= NImageDimension;
-
-
-  if (!img->GetPixelContainer()->GetContainerManageMemory())
-    {
-    transferOwnership=false;
-    }
+  numberOfElements *= NLength;
 
 
   typename VectorImageType::Pointer out = VectorImageType::New();
 
-  // Set the image's pixel container to import the pointer provided.
-  out->GetPixelContainer()->SetImportPointer(buffer, numberOfElements, transferOwnership );
-  img->GetPixelContainer()->SetContainerManageMemory(!transferOwnership);
   out->CopyInformation( img );
   out->SetRegions( img->GetBufferedRegion() );
 
+  if ( !transferOwnership )
+    {
+    // The output references the buffer, which remains owned by the input.
+    out->GetPixelContainer()->SetImportPointer(buffer, numberOfElements, false );
+    }
+  else if ( CanTransferImageBuffer( img->GetPixelContainer(), out->GetPixelContainer() ) )
+    {
+    // Set the image's pixel container to import the pointer provided.
+    out->GetPixelContainer()->SetImportPointer(buffer, numberOfElements, true );
+    img->GetPixelContainer()->ContainerManageMemoryOff();
+    }
+  else
+    {
+    out->SetVectorLength( NLength );
+    out->Allocate();
+    std::copy( buffer, buffer + numberOfElements, out->GetBufferPointer() );
+    }
+
   return out;
 }
 
@@ -207,12 +207,22 @@ typedef typelist::Append<
  */
 typedef AllPixelIDTypeList InstantiatedPixelIDTypeList;
 
-/** SimpleElastix and SimpleTransformix is compiled with float pixel type only. This
+/** SimpleTransformix is compiled with float pixel type only. This
  * saves compile time and reduces binary size. Images are automacially casted to and
  * from float before and after registration.
  */
 typedef typelist::MakeTypeList< BasicPixelID< float > >::Type FloatPixelIDTypeList;
 
+/** With native pixel types on, SimpleElastix registers fixed and moving images of these
+ * pixel types without casting when both are of the same type. Other combinations are
+ * casted to float. The
+ * list must match the ELASTIX_IMAGE_<N>D_PIXELTYPES that elastix is compiled with.
+ */
+typedef typelist::MakeTypeList< BasicPixelID< float >,
+                                BasicPixelID< int16_t >,
+                                BasicPixelID< uint16_t >,
+                                BasicPixelID< uint8_t > >::Type ElastixPixelIDTypeList;
+
 }
 }
 #endif // _sitkPixelIDTypeLists_h
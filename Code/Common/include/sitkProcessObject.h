@@ -23,7 +23,9 @@
 #include "sitkTemplateFunctions.h"
 #include "sitkEvent.h"
 #include "sitkImage.h"
+#include "sitkImageBufferAllocator.h"
 
+#include <algorithm>
 #include <iostream>
 #include <list>
 
@@ -301,12 +303,26 @@ namespace itk {
         numberOfElements *= VImageDimension;
 
         typename VectorImageType::Pointer out = VectorImageType::New();
-
-        // Set the image's pixel container to import the pointer provided.
-        out->GetPixelContainer()->SetImportPointer(buffer, numberOfElements, true );
-        img->GetPixelContainer()->ContainerManageMemoryOff();
         out->CopyInformation( img );
-        out->SetRegions( img->GetBufferedRegion() );
+        out->SetBufferedRegion( img->GetBufferedRegion() );
+        out->SetRequestedRegion( img->GetBufferedRegion() );
+
+        // The buffer is only adopted when both containers release it
+        // the same way. An allocator set by another thread during the
+        // Execute may have made the containers differ.
+        if ( ImageBufferOwner::IsSameOwner( img->GetPixelContainer(), out->GetPixelContainer() )
+             && img->GetPixelContainer()->GetContainerManageMemory() )
+          {
+          // Set the image's pixel container to import the pointer provided.
+          out->GetPixelContainer()->SetImportPointer(buffer, numberOfElements, true );
+          img->GetPixelContainer()->ContainerManageMemoryOff();
+          }
+        else
+          {
+          out->SetVectorLength( VImageDimension );
+          out->Allocate();
+          std::copy( buffer, buffer + numberOfElements, out->GetBufferPointer() );
+          }
 
         return Image(out.GetPointer());
       }
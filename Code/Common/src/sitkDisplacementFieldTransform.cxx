@@ -78,8 +78,8 @@ typename itk::Image<itk::Vector<double,NDimension>,NDimension>::Pointer
   typedef typename itk::Image<itk::Vector<double,NDimension>,NDimension> ImageVectorType;
   typename ImageVectorType::Pointer out = GetImageFromVectorImage(image.GetPointer(), true );
 
-  // With the above the itk::Image has taken ownership, so the input
-  // image is set to a new empty image.
+  // With the above the itk::Image has taken ownership of the buffer
+  // or a copy of it, so the input image is set to a new empty image.
   inImage = Image();
 
   return out;
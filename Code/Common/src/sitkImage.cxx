@@ -24,12 +24,96 @@
 #include "sitkPimpleImageBase.h"
 #include "sitkPixelIDTypeLists.h"
 
+#include <algorithm>
+
 
 namespace itk
 {
   namespace simple
   {
 
+  namespace
+  {
+
+  template< typename TBufferType >
+  void CopyLine( const TBufferType *imageLine, TBufferType *regionLine, uint64_t length )
+  {
+    std::copy( imageLine, imageLine + length, regionLine );
+  }
+
+  template< typename TBufferType >
+  void CopyLine( TBufferType *imageLine, const TBufferType *regionLine, uint64_t length )
+  {
+    std::copy( regionLine, regionLine + length, imageLine );
+  }
+
+  // Copies the region given by index and size between the buffer of
+  // an image and a contiguous buffer, one line along x at a time. The
+  // constness of the buffers selects the direction of the copy.
+  template< typename TImageBufferType, typename TRegionBufferType >
+  void CopyRegion( TImageBufferType *imageBuffer,
+                   TRegionBufferType *regionBuffer,
+                   const std::vector<unsigned int> &bufferedIndex,
+                   const std::vector<unsigned int> &bufferedSize,
+                   unsigned int numberOfComponents,
+                   const std::vector<uint32_t> &index,
+                   const std::vector<uint32_t> &size )
+  {
+    const unsigned int dimension = bufferedSize.size();
+    if ( index.size() < dimension || size.size() < dimension )
+      {
+      sitkExceptionMacro( "The index and size of the region must have at least " << dimension << " elements!" );
+      }
+
+    uint64_t numberOfLines = 1;
+    for ( unsigned int d = 0; d < dimension; ++d )
+      {
+      if ( index[d] < bufferedIndex[d]
+           || static_cast<uint64_t>( index[d] ) + size[d] > static_cast<uint64_t>( bufferedIndex[d] ) + bufferedSize[d] )
+        {
+        sitkExceptionMacro( "The region with index " << index << " and size " << size
+                            << " is outside of the buffered region of the image!" );
+        }
+      if ( d > 0 )
+        {
+        numberOfLines *= size[d];
+        }
+      }
+
+    if ( size[0] == 0 )
+      {
+      return;
+      }
+
+    const uint64_t lineLength = static_cast<uint64_t>( size[0] ) * numberOfComponents;
+    std::vector<uint32_t> lineIndex( index.begin(), index.begin() + dimension );
+    for ( uint64_t line = 0; line < numberOfLines; ++line )
+      {
+      uint64_t offset = 0;
+      uint64_t stride = 1;
+      for ( unsigned int d = 0; d < dimension; ++d )
+        {
+        offset += ( lineIndex[d] - bufferedIndex[d] ) * stride;
+        stride *= bufferedSize[d];
+        }
+      offset *= numberOfComponents;
+
+      CopyLine( imageBuffer + offset, regionBuffer, lineLength );
+      regionBuffer += lineLength;
+
+      for ( unsigned int d = 1; d < dimension; ++d )
+        {
+        if ( ++lineIndex[d] < index[d] + size[d] )
+          {
+          break;
+          }
+        lineIndex[d] = index[d];
+        }
+      }
+  }
+
+  }
+
   Image::~Image( )
   {
     delete this->m_PimpleImage;
@@ -69,20 +153,21 @@ namespace itk
       Allocate ( Width, Height, Depth, 0, ValueEnum, 0 );
     }
 
-    Image::Image( const std::vector< unsigned int > &size, PixelIDValueEnum ValueEnum, unsigned int numberOfComponents )
+    Image::Image( const std::vector< unsigned int > &size, PixelIDValueEnum ValueEnum, unsigned int numberOfComponents,
+                  BufferInitializationEnum bufferInitialization )
       : m_PimpleImage( NULL )
     {
       if ( size.size() == 2 )
         {
-        Allocate ( size[0], size[1], 0, 0, ValueEnum, numberOfComponents );
+        Allocate ( size[0], size[1], 0, 0, ValueEnum, numberOfComponents, bufferInitialization );
         }
       else if ( size.size() == 3 )
         {
-        Allocate ( size[0], size[1], size[2], 0, ValueEnum, numberOfComponents );
+        Allocate ( size[0], size[1], size[2], 0, ValueEnum, numberOfComponents, bufferInitialization );
         }
       else if ( size.size() == 4 )
         {
-        Allocate ( size[0], size[1], size[2], size[3], ValueEnum, numberOfComponents );
+        Allocate ( size[0], size[1], size[2], size[3], ValueEnum, numberOfComponents, bufferInitialization );
         }
       else
         {
@@ -149,6 +234,18 @@ namespace itk
       return this->m_PimpleImage->GetSize();
     }
 
+    std::vector< unsigned int > Image::GetBufferedIndex( void ) const
+    {
+      assert( m_PimpleImage );
+      return this->m_PimpleImage->GetBufferedIndex();
+    }
+
+    std::vector< unsigned int > Image::GetBufferedSize( void ) const
+    {
+      assert( m_PimpleImage );
+      return this->m_PimpleImage->GetBufferedSize();
+    }
+
     unsigned int Image::GetWidth( void ) const
     {
       assert( m_PimpleImage );
@@ -567,6 +664,176 @@ namespace itk
       return this->m_PimpleImage->GetBufferAsDouble( );
     }
 
+    void Image::GetRegionAsInt8( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, int8_t *buffer ) const
+    {
+      assert( m_PimpleImage );
+      CopyRegion( static_cast<const PimpleImageBase *>( this->m_PimpleImage )->GetBufferAsInt8(), buffer,
+                  this->GetBufferedIndex(), this->GetBufferedSize(), this->GetNumberOfComponentsPerPixel(),
+                  index, size );
+    }
+
+    void Image::GetRegionAsUInt8( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, uint8_t *buffer ) const
+    {
+      assert( m_PimpleImage );
+      CopyRegion( static_cast<const PimpleImageBase *>( this->m_PimpleImage )->GetBufferAsUInt8(), buffer,
+                  this->GetBufferedIndex(), this->GetBufferedSize(), this->GetNumberOfComponentsPerPixel(),
+                  index, size );
+    }
+
+    void Image::GetRegionAsInt16( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, int16_t *buffer ) const
+    {
+      assert( m_PimpleImage );
+      CopyRegion( static_cast<const PimpleImageBase *>( this->m_PimpleImage )->GetBufferAsInt16(), buffer,
+                  this->GetBufferedIndex(), this->GetBufferedSize(), this->GetNumberOfComponentsPerPixel(),
+                  index, size );
+    }
+
+    void Image::GetRegionAsUInt16( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, uint16_t *buffer ) const
+    {
+      assert( m_PimpleImage );
+      CopyRegion( static_cast<const PimpleImageBase *>( this->m_PimpleImage )->GetBufferAsUInt16(), buffer,
+                  this->GetBufferedIndex(), this->GetBufferedSize(), this->GetNumberOfComponentsPerPixel(),
+                  index, size );
+    }
+
+    void Image::GetRegionAsInt32( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, int32_t *buffer ) const
+    {
+      assert( m_PimpleImage );
+      CopyRegion( static_cast<const PimpleImageBase *>( this->m_PimpleImage )->GetBufferAsInt32(), buffer,
+                  this->GetBufferedIndex(), this->GetBufferedSize(), this->GetNumberOfComponentsPerPixel(),
+                  index, size );
+    }
+
+    void Image::GetRegionAsUInt32( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, uint32_t *buffer ) const
+    {
+      assert( m_PimpleImage );
+      CopyRegion( static_cast<const PimpleImageBase *>( this->m_PimpleImage )->GetBufferAsUInt32(), buffer,
+                  this->GetBufferedIndex(), this->GetBufferedSize(), this->GetNumberOfComponentsPerPixel(),
+                  index, size );
+    }
+
+    void Image::GetRegionAsInt64( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, int64_t *buffer ) const
+    {
+      assert( m_PimpleImage );
+      CopyRegion( static_cast<const PimpleImageBase *>( this->m_PimpleImage )->GetBufferAsInt64(), buffer,
+                  this->GetBufferedIndex(), this->GetBufferedSize(), this->GetNumberOfComponentsPerPixel(),
+                  index, size );
+    }
+
+    void Image::GetRegionAsUInt64( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, uint64_t *buffer ) const
+    {
+      assert( m_PimpleImage );
+      CopyRegion( static_cast<const PimpleImageBase *>( this->m_PimpleImage )->GetBufferAsUInt64(), buffer,
+                  this->GetBufferedIndex(), this->GetBufferedSize(), this->GetNumberOfComponentsPerPixel(),
+                  index, size );
+    }
+
+    void Image::GetRegionAsFloat( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, float *buffer ) const
+    {
+      assert( m_PimpleImage );
+      CopyRegion( static_cast<const PimpleImageBase *>( this->m_PimpleImage )->GetBufferAsFloat(), buffer,
+                  this->GetBufferedIndex(), this->GetBufferedSize(), this->GetNumberOfComponentsPerPixel(),
+                  index, size );
+    }
+
+    void Image::GetRegionAsDouble( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, double *buffer ) const
+    {
+      assert( m_PimpleImage );
+      CopyRegion( static_cast<const PimpleImageBase *>( this->m_PimpleImage )->GetBufferAsDouble(), buffer,
+                  this->GetBufferedIndex(), this->GetBufferedSize(), this->GetNumberOfComponentsPerPixel(),
+                  index, size );
+    }
+
+    void Image::SetRegionAsInt8( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, const int8_t *buffer )
+    {
+      assert( m_PimpleImage );
+      this->MakeUnique();
+      CopyRegion( this->m_PimpleImage->GetBufferAsInt8(), buffer,
+                  this->GetBufferedIndex(), this->GetBufferedSize(), this->GetNumberOfComponentsPerPixel(),
+                  index, size );
+    }
+
+    void Image::SetRegionAsUInt8( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, const uint8_t *buffer )
+    {
+      assert( m_PimpleImage );
+      this->MakeUnique();
+      CopyRegion( this->m_PimpleImage->GetBufferAsUInt8(), buffer,
+                  this->GetBufferedIndex(), this->GetBufferedSize(), this->GetNumberOfComponentsPerPixel(),
+                  index, size );
+    }
+
+    void Image::SetRegionAsInt16( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, const int16_t *buffer )
+    {
+      assert( m_PimpleImage );
+      this->MakeUnique();
+      CopyRegion( this->m_PimpleImage->GetBufferAsInt16(), buffer,
+                  this->GetBufferedIndex(), this->GetBufferedSize(), this->GetNumberOfComponentsPerPixel(),
+                  index, size );
+    }
+
+    void Image::SetRegionAsUInt16( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, const uint16_t *buffer )
+    {
+      assert( m_PimpleImage );
+      this->MakeUnique();
+      CopyRegion( this->m_PimpleImage->GetBufferAsUInt16(), buffer,
+                  this->GetBufferedIndex(), this->GetBufferedSize(), this->GetNumberOfComponentsPerPixel(),
+                  index, size );
+    }
+
+    void Image::SetRegionAsInt32( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, const int32_t *buffer )
+    {
+      assert( m_PimpleImage );
+      this->MakeUnique();
+      CopyRegion( this->m_PimpleImage->GetBufferAsInt32(), buffer,
+                  this->GetBufferedIndex(), this->GetBufferedSize(), this->GetNumberOfComponentsPerPixel(),
+                  index, size );
+    }
+
+    void Image::SetRegionAsUInt32( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, const uint32_t *buffer )
+    {
+      assert( m_PimpleImage );
+      this->MakeUnique();
+      CopyRegion( this->m_PimpleImage->GetBufferAsUInt32(), buffer,
+                  this->GetBufferedIndex(), this->GetBufferedSize(), this->GetNumberOfComponentsPerPixel(),
+                  index, size );
+    }
+
+    void Image::SetRegionAsInt64( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, const int64_t *buffer )
+    {
+      assert( m_PimpleImage );
+      this->MakeUnique();
+      CopyRegion( this->m_PimpleImage->GetBufferAsInt64(), buffer,
+                  this->GetBufferedIndex(), this->GetBufferedSize(), this->GetNumberOfComponentsPerPixel(),
+                  index, size );
+    }
+
+    void Image::SetRegionAsUInt64( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, const uint64_t *buffer )
+    {
+      assert( m_PimpleImage );
+      this->MakeUnique();
+      CopyRegion( this->m_PimpleImage->GetBufferAsUInt64(), buffer,
+                  this->GetBufferedIndex(), this->GetBufferedSize(), this->GetNumberOfComponentsPerPixel(),
+                  index, size );
+    }
+
+    void Image::SetRegionAsFloat( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, const float *buffer )
+    {
+      assert( m_PimpleImage );
+      this->MakeUnique();
+      CopyRegion( this->m_PimpleImage->GetBufferAsFloat(), buffer,
+                  this->GetBufferedIndex(), this->GetBufferedSize(), this->GetNumberOfComponentsPerPixel(),
+                  index, size );
+    }
+
+    void Image::SetRegionAsDouble( const std::vector<uint32_t> &index, const std::vector<uint32_t> &size, const double *buffer )
+    {
+      assert( m_PimpleImage );
+      this->MakeUnique();
+      CopyRegion( this->m_PimpleImage->GetBufferAsDouble(), buffer,
+                  this->GetBufferedIndex(), this->GetBufferedSize(), this->GetNumberOfComponentsPerPixel(),
+                  index, size );
+    }
+
     void Image::SetPixelAsInt8( const std::vector<uint32_t> &idx, int8_t v )
     {
       assert( m_PimpleImage );
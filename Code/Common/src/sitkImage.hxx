@@ -26,6 +26,7 @@
 #include "itkLabelObject.h"
 
 #include "sitkExceptionObject.h"
+#include "sitkImageBufferContainer.h"
 #include "sitkPimpleImageBase.hxx"
 #include "sitkPixelIDTypeLists.h"
 
@@ -70,9 +71,34 @@ namespace itk
   }
 
 
+  // Allocates the pixel buffer of an image from the current
+  // ImageBufferAllocator. The default allocator obtains a zero
+  // initialized buffer with calloc, which for large sizes returns
+  // fresh pages from the operating system that are already zero,
+  // instead of writing zeros over the whole buffer.
+  template<class TImageType>
+  void AllocateImageBuffer( TImageType *image, unsigned int numberOfComponents, BufferInitializationEnum bufferInitialization )
+  {
+    typedef typename TImageType::PixelContainer PixelContainerType;
+    typedef ImageBufferContainer<typename PixelContainerType::ElementIdentifier,
+                                 typename TImageType::InternalPixelType> BufferContainerType;
+
+    const size_t numberOfElements = static_cast<size_t>( image->GetBufferedRegion().GetNumberOfPixels() ) * numberOfComponents;
+
+    if ( numberOfElements == 0 )
+      {
+      image->Allocate();
+      return;
+      }
+
+    typename BufferContainerType::Pointer container = BufferContainerType::New();
+    container->Allocate( numberOfElements, bufferInitialization != sitkUninitialized );
+    image->SetPixelContainer( container );
+  }
+
   template<class TImageType>
   typename EnableIf<IsBasic<TImageType>::Value>::Type
-  Image::AllocateInternal ( unsigned int Width, unsigned int Height, unsigned int Depth, unsigned int dim4, unsigned int numberOfComponents )
+  Image::AllocateInternal ( unsigned int Width, unsigned int Height, unsigned int Depth, unsigned int dim4, unsigned int numberOfComponents, BufferInitializationEnum bufferInitialization )
   {
     if ( numberOfComponents != 1  && numberOfComponents != 0 )
       {
@@ -106,8 +132,7 @@ namespace itk
 
     typename TImageType::Pointer image = TImageType::New();
     image->SetRegions ( region );
-    image->Allocate();
-    image->FillBuffer ( itk::NumericTraits<typename TImageType::PixelType>::Zero );
+    AllocateImageBuffer( image.GetPointer(), 1, bufferInitialization );
 
     delete this->m_PimpleImage;
     this->m_PimpleImage = NULL;
@@ -116,7 +141,7 @@ namespace itk
 
   template<class TImageType>
   typename EnableIf<IsVector<TImageType>::Value>::Type
-  Image::AllocateInternal ( unsigned int Width, unsigned int Height, unsigned int Depth, unsigned int dim4, unsigned int numberOfComponents )
+  Image::AllocateInternal ( unsigned int Width, unsigned int Height, unsigned int Depth, unsigned int dim4, unsigned int numberOfComponents, BufferInitializationEnum bufferInitialization )
   {
     if ( numberOfComponents == 0 )
       {
@@ -126,7 +151,6 @@ namespace itk
     typename TImageType::IndexType  index;
     typename TImageType::SizeType   size;
     typename TImageType::RegionType region;
-    typename TImageType::PixelType  zero;
 
     index.Fill ( 0 );
     size.Fill(1);
@@ -148,14 +172,10 @@ namespace itk
     region.SetSize ( size );
     region.SetIndex ( index );
 
-    zero.SetSize( numberOfComponents );
-    zero.Fill ( itk::NumericTraits<typename TImageType::PixelType::ValueType>::Zero );
-
     typename TImageType::Pointer image = TImageType::New();
     image->SetRegions ( region );
     image->SetVectorLength( numberOfComponents );
-    image->Allocate();
-    image->FillBuffer ( zero );
+    AllocateImageBuffer( image.GetPointer(), numberOfComponents, bufferInitialization );
 
     delete this->m_PimpleImage;
     this->m_PimpleImage = NULL;
@@ -165,7 +185,7 @@ namespace itk
 
   template<class TImageType>
   typename EnableIf<IsLabel<TImageType>::Value>::Type
-  Image::AllocateInternal ( unsigned int Width, unsigned int Height, unsigned int Depth, unsigned int dim4, unsigned int numberOfComponents )
+  Image::AllocateInternal ( unsigned int Width, unsigned int Height, unsigned int Depth, unsigned int dim4, unsigned int numberOfComponents, BufferInitializationEnum bufferInitialization )
   {
     if ( numberOfComponents != 1 && numberOfComponents != 0 )
       {
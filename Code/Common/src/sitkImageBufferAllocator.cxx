@@ -0,0 +1,436 @@
+/*=========================================================================
+*
+*  Copyright Insight Software Consortium
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*         http://www.apache.org/licenses/LICENSE-2.0.txt
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*
+*=========================================================================*/
+#include "sitkImageBufferAllocator.h"
+#include "sitkImageBufferContainer.h"
+#include "sitkExceptionObject.h"
+
+#include <itkObjectFactoryBase.h>
+#include <itkCreateObjectFunction.h>
+#include <itkSimpleFastMutexLock.h>
+#include <itkMutexLockHolder.h>
+#include <itkVector.h>
+#include <itkVersion.h>
+
+#include <complex>
+#include <cstdlib>
+#include <cstring>
+#include <typeinfo>
+
+#ifdef _WIN32
+#include <malloc.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#if defined(_MSC_VER)
+#define SITK_THREAD_LOCAL __declspec(thread)
+#else
+#define SITK_THREAD_LOCAL __thread
+#endif
+
+namespace itk
+{
+namespace simple
+{
+
+namespace
+{
+
+class MallocImageBufferAllocator
+  : public ImageBufferAllocator
+{
+public:
+  virtual void *Allocate( size_t size, bool zeroInitialize )
+    {
+      if ( zeroInitialize )
+        {
+        // calloc obtains large buffers as zeroed pages from the
+        // operating system, which are only committed when touched
+        return std::calloc( size, 1 );
+        }
+      return std::malloc( size );
+    }
+
+  virtual void Deallocate( void *buffer, size_t )
+    {
+      std::free( buffer );
+    }
+};
+
+
+// Replaces the pixel containers created by ITK, so that the buffers
+// of filter outputs are also obtained from the current allocator.
+class ImageBufferContainerFactory
+  : public itk::ObjectFactoryBase
+{
+public:
+  typedef ImageBufferContainerFactory   Self;
+  typedef itk::ObjectFactoryBase        Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  itkFactorylessNewMacro( Self );
+  itkTypeMacro( ImageBufferContainerFactory, itk::ObjectFactoryBase );
+
+  virtual const char *GetITKSourceVersion( void ) const
+    {
+      return ITK_SOURCE_VERSION;
+    }
+
+  virtual const char *GetDescription( void ) const
+    {
+      return "SimpleITK image buffer container factory";
+    }
+
+protected:
+  ImageBufferContainerFactory( void )
+    {
+      // Vector images produced by ITK filters are handed over to
+      // VectorImages by CastITKToImage, so both containers must use
+      // the same allocation
+      this->RegisterScalarAndVectorContainers<char>();
+      this->RegisterScalarAndVectorContainers<signed char>();
+      this->RegisterScalarAndVectorContainers<unsigned char>();
+      this->RegisterScalarAndVectorContainers<short>();
+      this->RegisterScalarAndVectorContainers<unsigned short>();
+      this->RegisterScalarAndVectorContainers<int>();
+      this->RegisterScalarAndVectorContainers<unsigned int>();
+      this->RegisterScalarAndVectorContainers<long>();
+      this->RegisterScalarAndVectorContainers<unsigned long>();
+      this->RegisterScalarAndVectorContainers<long long>();
+      this->RegisterScalarAndVectorContainers<unsigned long long>();
+      this->RegisterScalarAndVectorContainers<float>();
+      this->RegisterScalarAndVectorContainers<double>();
+      this->RegisterContainer< std::complex<float> >();
+      this->RegisterContainer< std::complex<double> >();
+    }
+
+private:
+  ImageBufferContainerFactory( const Self & ); // purposely not implemented
+  void operator=( const Self & );              // purposely not implemented
+
+  template< typename TComponent >
+  void RegisterScalarAndVectorContainers( void )
+    {
+      this->RegisterContainer< TComponent >();
+      this->RegisterContainer< itk::Vector<TComponent, 2> >();
+      this->RegisterContainer< itk::Vector<TComponent, 3> >();
+      this->RegisterContainer< itk::Vector<TComponent, 4> >();
+    }
+
+  template< typename TElement >
+  void RegisterContainer( void )
+    {
+      typedef itk::ImportImageContainer< itk::SizeValueType, TElement > BaseType;
+      typedef ImageBufferContainer< itk::SizeValueType, TElement >     ContainerType;
+
+      this->RegisterOverride( typeid( BaseType ).name(),
+                              typeid( ContainerType ).name(),
+                              "SimpleITK image buffer container",
+                              true,
+                              itk::CreateObjectFunction<ContainerType>::New() );
+    }
+};
+
+
+ImageBufferAllocator *globalAllocator = SITK_NULLPTR;
+SITK_THREAD_LOCAL ImageBufferAllocator *threadAllocator = SITK_NULLPTR;
+
+itk::SimpleFastMutexLock factoryMutex;
+bool factoryRegistered = false;
+
+// The container factory is only registered once a custom allocator
+// is used, so that ITK object creation is unaffected otherwise.
+void RegisterImageBufferContainerFactory( void )
+{
+  itk::MutexLockHolder<itk::SimpleFastMutexLock> lock( factoryMutex );
+  if ( !factoryRegistered )
+    {
+    ImageBufferContainerFactory::Pointer factory = ImageBufferContainerFactory::New();
+    itk::ObjectFactoryBase::RegisterFactory( factory );
+    factoryRegistered = true;
+    }
+}
+
+}
+
+
+ImageBufferAllocator::~ImageBufferAllocator( void )
+{
+}
+
+void ImageBufferAllocator::SetGlobalAllocator( ImageBufferAllocator *allocator )
+{
+  if ( allocator != SITK_NULLPTR )
+    {
+    RegisterImageBufferContainerFactory();
+    }
+  globalAllocator = allocator;
+}
+
+ImageBufferAllocator *ImageBufferAllocator::GetGlobalAllocator( void )
+{
+  return globalAllocator;
+}
+
+void ImageBufferAllocator::SetThreadAllocator( ImageBufferAllocator *allocator )
+{
+  if ( allocator != SITK_NULLPTR )
+    {
+    RegisterImageBufferContainerFactory();
+    }
+  threadAllocator = allocator;
+}
+
+ImageBufferAllocator *ImageBufferAllocator::GetThreadAllocator( void )
+{
+  return threadAllocator;
+}
+
+ImageBufferAllocator *ImageBufferAllocator::GetAllocator( void )
+{
+  if ( threadAllocator != SITK_NULLPTR )
+    {
+    return threadAllocator;
+    }
+  if ( globalAllocator != SITK_NULLPTR )
+    {
+    return globalAllocator;
+    }
+  return GetDefaultAllocator();
+}
+
+ImageBufferAllocator *ImageBufferAllocator::GetDefaultAllocator( void )
+{
+  static MallocImageBufferAllocator defaultAllocator;
+  return &defaultAllocator;
+}
+
+
+AlignedImageBufferAllocator::AlignedImageBufferAllocator( size_t alignment )
+  : m_Alignment( alignment )
+{
+  if ( alignment == 0 || ( alignment & ( alignment - 1 ) ) != 0 )
+    {
+    sitkExceptionMacro( "Alignment of " << alignment << " is not a power of two" );
+    }
+}
+
+void *AlignedImageBufferAllocator::Allocate( size_t size, bool zeroInitialize )
+{
+  if ( size == 0 )
+    {
+    return SITK_NULLPTR;
+    }
+
+#ifdef _WIN32
+  void *buffer = _aligned_malloc( size, this->m_Alignment );
+  if ( buffer != SITK_NULLPTR && zeroInitialize )
+    {
+    std::memset( buffer, 0, size );
+    }
+  return buffer;
+#else
+  // Anonymous mappings are zero filled by the operating system as
+  // pages are touched, so zeroInitialize comes for free.
+  const size_t pageSize = static_cast<size_t>( sysconf( _SC_PAGESIZE ) );
+  const size_t alignment = this->m_Alignment > pageSize ? this->m_Alignment : pageSize;
+  const size_t length = ( size + pageSize - 1 ) / pageSize * pageSize;
+  if ( length < size || length + alignment < length )
+    {
+    return SITK_NULLPTR;
+    }
+
+  // Over allocate, then unmap the unaligned head and the tail
+  const size_t mappedLength = length + alignment - pageSize;
+  void *mapping = mmap( SITK_NULLPTR, mappedLength, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+  if ( mapping == MAP_FAILED )
+    {
+    return SITK_NULLPTR;
+    }
+
+  char *begin = static_cast<char *>( mapping );
+  char *buffer = begin + ( alignment - reinterpret_cast<size_t>( begin ) % alignment ) % alignment;
+  if ( buffer != begin )
+    {
+    munmap( begin, buffer - begin );
+    }
+  if ( buffer + length != begin + mappedLength )
+    {
+    munmap( buffer + length, ( begin + mappedLength ) - ( buffer + length ) );
+    }
+
+#if defined(MADV_HUGEPAGE)
+  if ( this->m_Alignment >= HugePageAlignment )
+    {
+    madvise( buffer, length, MADV_HUGEPAGE );
+    }
+#endif
+
+  (void)zeroInitialize;
+  return buffer;
+#endif
+}
+
+void AlignedImageBufferAllocator::Deallocate( void *buffer, size_t size )
+{
+  if ( buffer == SITK_NULLPTR )
+    {
+    return;
+    }
+#ifdef _WIN32
+  (void)size;
+  _aligned_free( buffer );
+#else
+  const size_t pageSize = static_cast<size_t>( sysconf( _SC_PAGESIZE ) );
+  munmap( buffer, ( size + pageSize - 1 ) / pageSize * pageSize );
+#endif
+}
+
+
+ImageBufferPool::ImageBufferPool( size_t maximumCachedSize, ImageBufferAllocator *source )
+  : m_Source( source != SITK_NULLPTR ? source : GetDefaultAllocator() ),
+    m_MaximumCachedSize( maximumCachedSize ),
+    m_CachedSize( 0 ),
+    m_Mutex( new itk::SimpleFastMutexLock )
+{
+}
+
+ImageBufferPool::~ImageBufferPool( void )
+{
+  this->ReleaseCachedBuffers();
+  delete this->m_Mutex;
+}
+
+void *ImageBufferPool::Allocate( size_t size, bool zeroInitialize )
+{
+  const size_t bucketSize = GetBucketSize( size );
+  if ( bucketSize < size )
+    {
+    return SITK_NULLPTR;
+    }
+
+  void *buffer = SITK_NULLPTR;
+  {
+  itk::MutexLockHolder<itk::SimpleFastMutexLock> lock( *this->m_Mutex );
+  BucketMapType::iterator it = this->m_Buckets.find( bucketSize );
+  if ( it != this->m_Buckets.end() && !it->second.empty() )
+    {
+    buffer = it->second.back();
+    it->second.pop_back();
+    this->m_CachedSize -= bucketSize;
+    }
+  }
+
+  if ( buffer == SITK_NULLPTR )
+    {
+    return this->m_Source->Allocate( bucketSize, zeroInitialize );
+    }
+
+  if ( zeroInitialize )
+    {
+    std::memset( buffer, 0, size );
+    }
+  return buffer;
+}
+
+void ImageBufferPool::Deallocate( void *buffer, size_t size )
+{
+  if ( buffer == SITK_NULLPTR )
+    {
+    return;
+    }
+
+  const size_t bucketSize = GetBucketSize( size );
+  {
+  itk::MutexLockHolder<itk::SimpleFastMutexLock> lock( *this->m_Mutex );
+  if ( this->m_CachedSize + bucketSize <= this->m_MaximumCachedSize &&
+       this->m_CachedSize + bucketSize >= this->m_CachedSize )
+    {
+    this->m_Buckets[bucketSize].push_back( buffer );
+    this->m_CachedSize += bucketSize;
+    return;
+    }
+  }
+
+  this->m_Source->Deallocate( buffer, bucketSize );
+}
+
+void ImageBufferPool::SetMaximumCachedSize( size_t size )
+{
+  itk::MutexLockHolder<itk::SimpleFastMutexLock> lock( *this->m_Mutex );
+  this->m_MaximumCachedSize = size;
+}
+
+size_t ImageBufferPool::GetMaximumCachedSize( void ) const
+{
+  itk::MutexLockHolder<itk::SimpleFastMutexLock> lock( *this->m_Mutex );
+  return this->m_MaximumCachedSize;
+}
+
+size_t ImageBufferPool::GetCachedSize( void ) const
+{
+  itk::MutexLockHolder<itk::SimpleFastMutexLock> lock( *this->m_Mutex );
+  return this->m_CachedSize;
+}
+
+void ImageBufferPool::ReleaseCachedBuffers( void )
+{
+  BucketMapType buckets;
+  {
+  itk::MutexLockHolder<itk::SimpleFastMutexLock> lock( *this->m_Mutex );
+  buckets.swap( this->m_Buckets );
+  this->m_CachedSize = 0;
+  }
+
+  for ( BucketMapType::iterator it = buckets.begin(); it != buckets.end(); ++it )
+    {
+    for ( size_t i = 0; i < it->second.size(); ++i )
+      {
+      this->m_Source->Deallocate( it->second[i], it->first );
+      }
+    }
+}
+
+size_t ImageBufferPool::GetBucketSize( size_t size )
+{
+  // Small sizes are rounded to the next power of two, larger sizes to
+  // a quarter step between powers of two, wasting at most 25%
+  const size_t minimumBucketSize = 4096;
+  if ( size <= minimumBucketSize )
+    {
+    size_t bucketSize = 64;
+    while ( bucketSize < size )
+      {
+      bucketSize *= 2;
+      }
+    return bucketSize;
+    }
+
+  size_t powerOfTwo = minimumBucketSize;
+  while ( powerOfTwo * 2 < size && powerOfTwo * 2 > powerOfTwo )
+    {
+    powerOfTwo *= 2;
+    }
+  const size_t step = powerOfTwo / 4;
+  return ( size + step - 1 ) / step * step;
+}
+
+}
+}
@@ -0,0 +1,140 @@
+/*=========================================================================
+*
+*  Copyright Insight Software Consortium
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*         http://www.apache.org/licenses/LICENSE-2.0.txt
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*
+*=========================================================================*/
+#ifndef sitkImageBufferContainer_h
+#define sitkImageBufferContainer_h
+
+#include "sitkCommon.h"
+#include "sitkImageBufferAllocator.h"
+
+#include <itkImportImageContainer.h>
+
+#include <limits>
+
+namespace itk
+{
+  namespace simple
+  {
+
+  /** \class ImageBufferContainer
+   * \brief A pixel container whose buffers come from an ImageBufferAllocator
+   *
+   * The container uses the allocator current when it was created,
+   * both for the buffers it allocates itself and for the ones ITK
+   * reserves through it, and returns them to that allocator.
+   */
+  template< typename TElementIdentifier, typename TElement >
+  class SITKCommon_HIDDEN ImageBufferContainer
+    : public ImportImageContainer< TElementIdentifier, TElement >,
+      public ImageBufferOwner
+  {
+  public:
+    typedef ImageBufferContainer                                 Self;
+    typedef ImportImageContainer< TElementIdentifier, TElement > Superclass;
+    typedef SmartPointer< Self >                                 Pointer;
+    typedef SmartPointer< const Self >                           ConstPointer;
+
+    typedef typename Superclass::ElementIdentifier ElementIdentifier;
+
+    itkNewMacro( Self );
+    itkTypeMacro( ImageBufferContainer, ImportImageContainer );
+
+    virtual ImageBufferAllocator *GetAllocator( void ) const
+      {
+        return this->m_Allocator;
+      }
+
+    /** Allocate a buffer of numberOfElements elements, which are zero
+     * if zeroInitialize is true and undefined otherwise */
+    void Allocate( ElementIdentifier numberOfElements, bool zeroInitialize )
+      {
+        TElement *buffer = this->AllocateElements( numberOfElements, zeroInitialize );
+        this->SetImportPointer( buffer, numberOfElements, true );
+      }
+
+  protected:
+    ImageBufferContainer( void )
+      : m_Allocator( ImageBufferAllocator::GetAllocator() )
+      {
+      }
+
+    virtual ~ImageBufferContainer( void )
+      {
+        this->DeallocateManagedMemory();
+      }
+
+    virtual TElement *AllocateElements( ElementIdentifier size, bool useDefaultConstructor = false ) const
+      {
+        // Empty images, such as the default constructed Image, do not
+        // reach the allocator, which may not support empty buffers
+        if ( size == 0 )
+          {
+          return GetEmptyBuffer();
+          }
+
+        void *buffer = SITK_NULLPTR;
+        if ( static_cast<size_t>( size ) <= std::numeric_limits<size_t>::max() / sizeof( TElement ) )
+          {
+          buffer = this->m_Allocator->Allocate( static_cast<size_t>( size ) * sizeof( TElement ), useDefaultConstructor );
+          }
+        if ( buffer == SITK_NULLPTR )
+          {
+          throw MemoryAllocationError( __FILE__, __LINE__,
+                                       "Failed to allocate memory for image.",
+                                       ITK_LOCATION );
+          }
+        return static_cast<TElement *>( buffer );
+      }
+
+    virtual void DeallocateManagedMemory( void )
+      {
+        TElement *buffer = this->GetImportPointer();
+        if ( buffer != SITK_NULLPTR && this->GetContainerManageMemory() && this->GetCapacity() != 0 )
+          {
+          const size_t size = static_cast<size_t>( this->GetCapacity() ) * sizeof( TElement );
+
+          // The superclass only resets the container, as it no longer
+          // owns the buffer
+          this->ContainerManageMemoryOff();
+          Superclass::DeallocateManagedMemory();
+          this->m_Allocator->Deallocate( buffer, size );
+          }
+        else
+          {
+          // An empty buffer is not owned, only forgotten
+          this->ContainerManageMemoryOff();
+          Superclass::DeallocateManagedMemory();
+          }
+      }
+
+  private:
+    ImageBufferContainer( const Self & ); // purposely not implemented
+    void operator=( const Self & );       // purposely not implemented
+
+    static TElement *GetEmptyBuffer( void )
+      {
+        static TElement emptyBuffer[1];
+        return emptyBuffer;
+      }
+
+    ImageBufferAllocator *m_Allocator;
+  };
+
+  }
+}
+
+#endif // sitkImageBufferContainer_h
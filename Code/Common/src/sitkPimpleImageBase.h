@@ -58,6 +58,8 @@ namespace itk
 
     virtual std::vector< unsigned int > GetSize( void ) const = 0;
     virtual unsigned int GetSize( unsigned int dimension ) const = 0;
+    virtual std::vector< unsigned int > GetBufferedIndex( void ) const = 0;
+    virtual std::vector< unsigned int > GetBufferedSize( void ) const = 0;
 
 
     virtual std::vector<double> GetOrigin( void ) const = 0;
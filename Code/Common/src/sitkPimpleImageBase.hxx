@@ -68,14 +68,16 @@ namespace itk
           sitkExceptionMacro( << "Unable to initialize an image with NULL" );
           }
 
-        if ( image->GetLargestPossibleRegion() != image->GetBufferedRegion() )
+        // A streamed image may only have a part of its
+        // LargestPossibleRegion buffered
+        if ( !image->GetLargestPossibleRegion().IsInside( image->GetBufferedRegion() ) )
           {
           sitkExceptionMacro( << "The image has a LargestPossibleRegion of " << image->GetLargestPossibleRegion()
                               << " while the buffered region is " << image->GetBufferedRegion() << std::endl
-                              << "SimpleITK does not support streamming or unbuffered regions!" );
+                              << "SimpleITK does not support buffered regions outside of the LargestPossibleRegion!" );
           }
 
-        const IndexType & idx = image->GetBufferedRegion().GetIndex();
+        const IndexType & idx = image->GetLargestPossibleRegion().GetIndex();
         for ( unsigned int i = 0; i < ImageType::ImageDimension; ++i )
           {
           if ( idx[i] != 0 )
@@ -273,6 +275,20 @@ namespace itk
         return sitkITKVectorToSTL<unsigned int>( largestRegion.GetSize() );
       }
 
+    virtual std::vector<unsigned int> GetBufferedIndex( void ) const
+      {
+        typename ImageType::RegionType bufferedRegion = this->m_Image->GetBufferedRegion();
+
+        return sitkITKVectorToSTL<unsigned int>( bufferedRegion.GetIndex() );
+      }
+
+    virtual std::vector<unsigned int> GetBufferedSize( void ) const
+      {
+        typename ImageType::RegionType bufferedRegion = this->m_Image->GetBufferedRegion();
+
+        return sitkITKVectorToSTL<unsigned int>( bufferedRegion.GetSize() );
+      }
+
     virtual uint64_t GetNumberOfPixels( void ) const
       {
         return this->m_Image->GetLargestPossibleRegion().GetNumberOfPixels();
@@ -641,7 +657,7 @@ namespace itk
     InternalGetPixel( const std::vector<uint32_t> &idx ) const
       {
         const IndexType itkIdx = sitkSTLVectorToITK<IndexType>( idx );
-        if ( ! this->m_Image->GetLargestPossibleRegion().IsInside( itkIdx ) )
+        if ( ! this->m_Image->GetBufferedRegion().IsInside( itkIdx ) )
           {
           sitkExceptionMacro( "index out of bounds" );
           }
@@ -656,7 +672,7 @@ namespace itk
     InternalGetPixel( const std::vector<uint32_t> &idx ) const
       {
         const IndexType itkIdx = sitkSTLVectorToITK<IndexType>( idx );
-        if ( ! this->m_Image->GetLargestPossibleRegion().IsInside( itkIdx ) )
+        if ( ! this->m_Image->GetBufferedRegion().IsInside( itkIdx ) )
           {
           sitkExceptionMacro( "index out of bounds" );
           }
@@ -671,7 +687,7 @@ namespace itk
     InternalGetPixel( const std::vector<uint32_t> &idx ) const
       {
         const IndexType itkIdx = sitkSTLVectorToITK<IndexType>( idx );
-        if ( ! this->m_Image->GetLargestPossibleRegion().IsInside( itkIdx ) )
+        if ( ! this->m_Image->GetBufferedRegion().IsInside( itkIdx ) )
           {
           sitkExceptionMacro( "index out of bounds" );
           }
@@ -742,7 +758,7 @@ namespace itk
     InternalSetPixel( const std::vector<uint32_t> &idx, const TPixelType v ) const
       {
         const IndexType itkIdx = sitkSTLVectorToITK<IndexType>( idx );
-        if ( ! this->m_Image->GetLargestPossibleRegion().IsInside( itkIdx ) )
+        if ( ! this->m_Image->GetBufferedRegion().IsInside( itkIdx ) )
           {
           sitkExceptionMacro( "index out of bounds" );
           }
@@ -756,7 +772,7 @@ namespace itk
     InternalSetPixel( const std::vector<uint32_t> &idx, const TPixelType v ) const
       {
         const IndexType itkIdx = sitkSTLVectorToITK<IndexType>( idx );
-        if ( ! this->m_Image->GetLargestPossibleRegion().IsInside( itkIdx ) )
+        if ( ! this->m_Image->GetBufferedRegion().IsInside( itkIdx ) )
           {
           sitkExceptionMacro( "index out of bounds" );
           }
@@ -770,7 +786,7 @@ namespace itk
     InternalSetPixel( const std::vector<uint32_t> &idx, const std::vector<TPixelValueType> & v  ) const
       {
         const IndexType itkIdx = sitkSTLVectorToITK<IndexType>( idx );
-        if ( ! this->m_Image->GetLargestPossibleRegion().IsInside( itkIdx ) )
+        if ( ! this->m_Image->GetBufferedRegion().IsInside( itkIdx ) )
           {
           sitkExceptionMacro( "index out of bounds" );
           }
@@ -21,6 +21,7 @@
 #include "itkProcessObject.h"
 #include "itkCommand.h"
 #include "itkImageToImageFilter.h"
+#include "itkImageBase.h"
 
 #include <iostream>
 #include <algorithm>
@@ -93,6 +94,70 @@ private:
   void operator=(const Self &);        //purposely not implemented
 };
 
+
+// When an input image of the filter is only partially buffered, the
+// output is restricted to the buffered region of that input so that
+// an image can be processed in slabs. Returns false if the filter's
+// output is not an image of dimension VImageDimension.
+template< unsigned int VImageDimension >
+bool RestrictOutputToBufferedInputRegion( itk::ProcessObject *p )
+{
+  typedef itk::ImageBase< VImageDimension > ImageBaseType;
+
+  const itk::ProcessObject::DataObjectPointerArray outputs = p->GetOutputs();
+  if ( outputs.empty() )
+    {
+    return false;
+    }
+
+  ImageBaseType *output = dynamic_cast< ImageBaseType* >( outputs[0].GetPointer() );
+  if ( output == NULL )
+    {
+    return false;
+    }
+
+  const itk::ProcessObject::DataObjectPointerArray inputs = p->GetInputs();
+
+  const ImageBaseType *streamedInput = NULL;
+  for ( unsigned int i = 0; i < inputs.size() && streamedInput == NULL; ++i )
+    {
+    const ImageBaseType *input = dynamic_cast< const ImageBaseType* >( inputs[i].GetPointer() );
+    if ( input != NULL && input->GetBufferedRegion() != input->GetLargestPossibleRegion() )
+      {
+      streamedInput = input;
+      }
+    }
+
+  if ( streamedInput == NULL )
+    {
+    return true;
+    }
+
+  p->UpdateOutputInformation();
+
+  typename ImageBaseType::RegionType region = streamedInput->GetBufferedRegion();
+  if ( !region.Crop( output->GetLargestPossibleRegion() ) )
+    {
+    sitkExceptionMacro( "The buffered region " << streamedInput->GetBufferedRegion()
+                        << " of the input image is outside of the output image!" );
+    }
+  output->SetRequestedRegion( region );
+  p->PropagateRequestedRegion( output );
+
+  // The inputs have no source to produce missing pixels
+  for ( unsigned int i = 0; i < inputs.size(); ++i )
+    {
+    const ImageBaseType *input = dynamic_cast< const ImageBaseType* >( inputs[i].GetPointer() );
+    if ( input != NULL && !input->GetBufferedRegion().IsInside( input->GetRequestedRegion() ) )
+      {
+      sitkExceptionMacro( "The filter " << p->GetNameOfClass() << " requires the region "
+                          << input->GetRequestedRegion() << " of an input image, which is not buffered!" );
+      }
+    }
+
+  return true;
+}
+
 } // end anonymous namespace
 
 //----------------------------------------------------------------------------
@@ -379,6 +444,13 @@ void ProcessObject::PreUpdate(itk::ProcessObject *p)
   // propagate number of threads
   p->SetNumberOfThreads(this->GetNumberOfThreads());
 
+  // process partially buffered inputs slab by slab
+  if ( !RestrictOutputToBufferedInputRegion<2>(p)
+       && !RestrictOutputToBufferedInputRegion<3>(p) )
+    {
+    RestrictOutputToBufferedInputRegion<4>(p);
+    }
+
   try
     {
     this->m_ActiveProcess = p;
@@ -3,11 +3,14 @@
 
 #include "sitkCommon.h"
 #include "sitkImage.h"
+#include "sitkProcessObject.h"
+#include "sitkTransform.h"
 
 namespace itk { 
   namespace simple {
 
 class SITKCommon_EXPORT ElastixImageFilter
+  : public ProcessObject
 {
   public:
 
@@ -15,6 +18,7 @@ class SITKCommon_EXPORT ElastixImageFilter
     ~ElastixImageFilter( void );
 
     typedef ElastixImageFilter Self;                                
+    typedef ProcessObject Superclass;
 
     typedef std::vector< Image >                                    VectorOfImage;
 
@@ -27,7 +31,15 @@ class SITKCommon_EXPORT ElastixImageFilter
     typedef ParameterMapType::iterator                              ParameterMapIterator;
     typedef ParameterMapType::const_iterator                        ParameterMapConstIterator;
 
-    const std::string GetName( void );
+    std::string GetName( void ) const;
+
+    /** The number of threads of one Execute(). As elastix only reads the
+     *  process wide ITK and OpenMP defaults, these are set to this value for
+     *  the duration of Execute(). Elastix executions in a process therefore
+     *  run one at a time, and ITK filters created by other threads meanwhile
+     *  also get this number of threads. 0 keeps the defaults. */
+    virtual void SetNumberOfThreads( unsigned int n );
+    virtual unsigned int GetNumberOfThreads( void ) const;
 
     Self& SetFixedImage( const Image& fixedImage );
     Self& SetFixedImage( const VectorOfImage& fixedImages );
@@ -47,6 +59,9 @@ class SITKCommon_EXPORT ElastixImageFilter
     Self& RemoveMovingImage( void );
     unsigned int GetNumberOfMovingImages();
 
+    /** Masks can be of any integer pixel type. Nonzero voxels are inside the
+     *  mask. Unsigned char masks are shared with elastix without a copy,
+     *  other masks are converted to unsigned char masks for each execution. */
     Self& SetFixedMask( const Image& fixedMask );
     Self& SetFixedMask( const VectorOfImage& fixedMasks );
     Self& AddFixedMask( const Image& fixedMask );
@@ -73,6 +88,16 @@ class SITKCommon_EXPORT ElastixImageFilter
     std::string GetMovingPointSetFileName( void );
     Self& RemoveMovingPointSetFileName( void );
 
+    /** Point sets as flat buffers of physical coordinates (x0, y0, [z0,] x1, y1, [z1,] ...).
+     *  An in-memory point set replaces a point set file name and vice versa. */
+    Self& SetFixedPointSet( const std::vector< double >& fixedPointSet );
+    std::vector< double > GetFixedPointSet( void );
+    Self& RemoveFixedPointSet( void );
+
+    Self& SetMovingPointSet( const std::vector< double >& movingPointSet );
+    std::vector< double > GetMovingPointSet( void );
+    Self& RemoveMovingPointSet( void );
+
     Self& SetOutputDirectory( const std::string outputDirectory );
     std::string GetOutputDirectory( void );
     Self& RemoveOutputDirectory( void );
@@ -92,21 +117,21 @@ class SITKCommon_EXPORT ElastixImageFilter
     Self& LogToConsoleOff();
 
     Self& SetParameterMap( const std::string transformName, const unsigned int numberOfResolutions = 4u, const double finalGridSpacingInPhysicalUnits = 10.0 );
-    Self& SetParameterMap( const std::vector< std::map< std::string, std::vector< std::string > > > parameterMapVector );
-    Self& SetParameterMap( const std::map< std::string, std::vector< std::string > > parameterMap );
-    Self& AddParameterMap( const std::map< std::string, std::vector< std::string > > parameterMap );
+    Self& SetParameterMap( const std::vector< std::map< std::string, std::vector< std::string > > >& parameterMapVector );
+    Self& SetParameterMap( const std::map< std::string, std::vector< std::string > >& parameterMap );
+    Self& AddParameterMap( const std::map< std::string, std::vector< std::string > >& parameterMap );
     std::vector< std::map< std::string, std::vector< std::string > > > GetParameterMap( void );
     std::map< std::string, std::vector< std::string > > GetDefaultParameterMap( const std::string transformName, const unsigned int numberOfResolutions = 4, const double finalGridSpacingInPhysicalUnits = 10.0 );
     unsigned int GetNumberOfParameterMaps( void );
 
     Self& SetParameter( const std::string key, const std::string value );
-    Self& SetParameter( const std::string key, const std::vector< std::string > value );
+    Self& SetParameter( const std::string key, const std::vector< std::string >& value );
     Self& SetParameter( const unsigned int index, const std::string key, const std::string value );
-    Self& SetParameter( const unsigned int index, const std::string key, const std::vector< std::string > value );
+    Self& SetParameter( const unsigned int index, const std::string key, const std::vector< std::string >& value );
     Self& AddParameter( const std::string key, const std::string value );
     Self& AddParameter( const unsigned int index, const std::string key, const std::string value );
-    Self& AddParameter( const std::string key, const std::vector< std::string > value );
-    Self& AddParameter( const unsigned int index, const std::string key, const std::vector< std::string > value );
+    Self& AddParameter( const std::string key, const std::vector< std::string >& value );
+    Self& AddParameter( const unsigned int index, const std::string key, const std::vector< std::string >& value );
     std::vector< std::string > GetParameter( const std::string key );
     std::vector< std::string > GetParameter( const unsigned int index, const std::string key );
     Self& RemoveParameter( const std::string key );
@@ -117,21 +142,169 @@ class SITKCommon_EXPORT ElastixImageFilter
     Self& RemoveInitialTransformParameterFileName( void );
 
     std::map< std::string, std::vector< std::string > > ReadParameterFile( const std::string filename );
-    Self& WriteParameterFile( const std::map< std::string, std::vector< std::string > > parameterMap, const std::string filename );
+    Self& WriteParameterFile( const std::map< std::string, std::vector< std::string > >& parameterMap, const std::string filename );
     
     Image Execute( void );
     std::vector< std::map< std::string, std::vector< std::string > > > GetTransformParameterMap( void );
     std::map< std::string, std::vector< std::string > > GetTransformParameterMap( const unsigned int index );
+
+    /** The result image shares its buffer with the filter. Modifying the
+     *  returned image copies the buffer first unless the filter has released
+     *  it. MoveResultImage() returns the result image and releases the
+     *  filter's reference, so the caller owns the only reference and can modify
+     *  it in place. Afterwards GetResultImage() throws until the next Execute().
+     *  Results kept in the result cache still share the buffer. */
     Image GetResultImage( void );
+    Image MoveResultImage( void );
+
+    /** Transform parameter maps of the last Execute() as an sitk::Transform.
+     *  See TransformParameterMapToTransform(). */
+    Transform GetTransform( void );
+
+    /** Starts Execute() on a worker thread and returns immediately. Wait()
+     *  blocks until the registration has finished, rethrows its errors and
+     *  returns the result image. IsDone() polls without blocking. Cancel()
+     *  makes Wait() throw; a registration that has not started yet is skipped,
+     *  a running one is not interrupted. Until Wait() has returned, other
+     *  methods of the filter except IsDone() and Cancel() throw. Input images are shared, not copied: modifying an input
+     *  image meanwhile copies its buffer first. Elastix executions of all
+     *  filter instances in a process run one at a time. */
+    Self& ExecuteAsync( void );
+    Image Wait( void );
+    bool IsDone( void );
+    Self& Cancel( void );
+
+    /** Registers the fixed image to each moving image with the current parameter
+     *  maps, masks and settings, and returns the result images in the same order.
+     *  The fixed image is casted to float and the fixed masks are binarized at
+     *  most once, and these buffers are shared by all registrations, whether or
+     *  not casts are cached. With native pixel types on, moving images of the
+     *  fixed image's pixel type are registered against the uncasted fixed
+     *  image. The transform
+     *  parameter maps of all registrations are available through
+     *  GetBatchTransformParameterMap(). Afterwards GetResultImage() and
+     *  GetTransformParameterMap() refer to the last registration. */
+    VectorOfImage ExecuteBatch( const Image& fixedImage, const VectorOfImage& movingImages );
+    std::vector< std::vector< std::map< std::string, std::vector< std::string > > > > GetBatchTransformParameterMap( void );
 
     std::vector< std::map< std::string, std::vector< std::string > > > ExecuteInverse( void );
     std::vector< std::map< std::string, std::vector< std::string > > > ExecuteInverse( std::map< std::string, std::vector< std::string > > inverseParameterMap );
     std::vector< std::map< std::string, std::vector< std::string > > > ExecuteInverse( std::vector< std::map< std::string, std::vector< std::string > > > inverseParameterMapVector );
     std::vector< std::map< std::string, std::vector< std::string > > > GetInverseTransformParameterMap( void );
 
+    /** Fixed images that must be casted to a pixel type elastix is compiled
+     *  with can be cached across executions, keyed on the image buffer, its
+     *  modified time and the target pixel type. The least recently used casts
+     *  are dropped when the cache exceeds its maximum size in bytes. The
+     *  default of 0 disables caching, so a cast is not kept alive after
+     *  Execute() unless a maximum size is set. */
+    Self& SetMaximumCacheSize( const uint64_t maximumCacheSize );
+    uint64_t GetMaximumCacheSize( void );
+    uint64_t GetCacheSize( void );
+    Self& ClearCache( void );
+
+    /** Caches registration results keyed on the content hashes and geometry
+     *  of all input images and masks, the content of initial transform and
+     *  point set files, and the parameter maps. Execute() with a cached key
+     *  returns the stored result image and transform parameter maps without
+     *  running elastix. Results are kept in memory (default 0 results, i.e.
+     *  disabled) and, if a result cache directory is set, on disk, where they
+     *  are shared between processes and survive them. Hashing reads every
+     *  input voxel once per Execute(). */
+    Self& SetMaximumNumberOfCachedResults( const unsigned int maximumNumberOfCachedResults );
+    unsigned int GetMaximumNumberOfCachedResults( void );
+    unsigned int GetNumberOfCachedResults( void );
+    Self& ClearResultCache( void );
+    Self& SetResultCacheDirectory( const std::string resultCacheDirectory );
+    std::string GetResultCacheDirectory( void );
+    Self& RemoveResultCacheDirectory( void );
+
+    /** Registers fixed and moving images cropped to the bounding box of the
+     *  nonzero voxels of their masks, padded by a number of voxels (default 8),
+     *  so pyramids are only computed over the region that is sampled. Images
+     *  without masks are not cropped. The transform parameter maps and the
+     *  result image refer to the full fixed image: after a registration on a
+     *  cropped fixed image, the moving image is resampled onto the full fixed
+     *  image with the ResampleInterpolator and DefaultPixelValue of the
+     *  maps. With fixed masks, only translation, Euler, similarity and affine
+     *  transforms are supported, as a B-spline control point grid would only
+     *  cover the cropped region. */
+    Self& SetCropToMasks( const bool cropToMasks );
+    bool GetCropToMasks( void );
+    Self& CropToMasksOn( void );
+    Self& CropToMasksOff( void );
+    Self& SetCropToMasksPadding( const unsigned int cropToMasksPadding );
+    unsigned int GetCropToMasksPadding( void );
+
+    /** Seeds the random number generator of the elastix samplers (the
+     *  "RandomSeed" parameter of all parameter maps) for every execution, so
+     *  registrations with the same inputs, seed and number of threads give
+     *  identical results. Any value, including 0, is passed on as is. By
+     *  default no seed is set and the "RandomSeed" parameter of the maps
+     *  applies, or elastix's own fixed default seed if they have none, so
+     *  results are repeatable but not seeded from the wall clock.
+     *  RemoveRandomSeed() restores this. GetRandomSeed() is only meaningful
+     *  when HasRandomSeed() is true. Changing the number of threads can still
+     *  change results slightly, since metric values and derivatives are
+     *  summed per thread. */
+    Self& SetRandomSeed( const unsigned int randomSeed );
+    unsigned int GetRandomSeed( void );
+    bool HasRandomSeed( void );
+    Self& RemoveRandomSeed( void );
+
+    /** Reduces the memory an execution needs, for large (e.g. 4D groupwise)
+     *  series. Fixed and moving images of a pixel type elastix is compiled
+     *  with are registered without a float copy, as with
+     *  UseNativePixelTypeOn(), so the result image and the pyramid images have
+     *  that pixel type. Casted fixed images are not kept in the cache after the
+     *  execution, and elastix computes the pyramid images of a resolution when
+     *  that resolution starts and releases them when it ends, unless the
+     *  parameter maps set ComputePyramidImagesPerResolution. In either mode a
+     *  moving image that is the same image as a fixed image shares its buffer
+     *  and cast. GetPeakMemoryUsage() returns the peak resident memory of the
+     *  process in bytes during the last registration (0 if unknown). On Linux
+     *  the process high-water mark is reset when a registration starts. On
+     *  other platforms the high-water mark can not be reset, and the value is
+     *  the process wide peak if an earlier peak was higher. */
+    Self& SetLowMemoryMode( const bool lowMemoryMode );
+    bool GetLowMemoryMode( void );
+    Self& LowMemoryModeOn( void );
+    Self& LowMemoryModeOff( void );
+    uint64_t GetPeakMemoryUsage( void );
+
+    /** By default all fixed and moving images are casted to float32, elastix
+     *  computes its internal images and pyramids in float32 and the result
+     *  image is float32. With native pixel types on, fixed and moving images
+     *  that all have the same pixel type of float32, int16, uint16 or uint8
+     *  are registered without the cast, which saves the memory of the float
+     *  copies. FixedInternalImagePixelType and MovingInternalImagePixelType
+     *  are then set to that type, so the smoothed pyramid images are rounded
+     *  to it, and the result image has that pixel type. Other combinations
+     *  are still casted to float32. Off by default, but low memory mode
+     *  registers images natively as well. */
+    Self& SetUseNativePixelType( const bool useNativePixelType );
+    bool GetUseNativePixelType( void );
+    Self& UseNativePixelTypeOn( void );
+    Self& UseNativePixelTypeOff( void );
+
+    /** Records the per-iteration table elastix writes for each parameter map
+     *  and resolution. After Execute(), GetIterationInfo() returns it as
+     *  columns of equal length, keyed on the elastix column name ("ItNr",
+     *  "Metric", "StepSize", "||Gradient||", "Time[ms]", ... depending on the
+     *  optimizer), plus "ParameterMap" and "Resolution" columns that index each
+     *  row. Values an optimizer does not report are NaN. Elastix writes the
+     *  tables to a private temporary directory, unless an output directory was
+     *  set with SetOutputDirectory(). Tables of earlier runs in that directory
+     *  are removed before elastix runs. */
+    Self& SetRecordIterationInfo( const bool recordIterationInfo );
+    bool GetRecordIterationInfo( void );
+    Self& RecordIterationInfoOn( void );
+    Self& RecordIterationInfoOff( void );
+    std::map< std::string, std::vector< double > > GetIterationInfo( void );
+
     Self& PrintParameterMap( void );
-    Self& PrintParameterMap( const ParameterMapType parameterMapVector );
-    Self& PrintParameterMap( const ParameterMapVectorType parameterMapVector );
+    Self& PrintParameterMap( const ParameterMapType& parameterMapVector );
+    Self& PrintParameterMap( const ParameterMapVectorType& parameterMapVector );
 
   private:
 
@@ -143,17 +316,24 @@ class SITKCommon_EXPORT ElastixImageFilter
 // Procedural Interface 
 SITKCommon_EXPORT std::map< std::string, std::vector< std::string > > GetDefaultParameterMap( const std::string transform, const unsigned int numberOfResolutions = 4, const double finalGridSpacingInPhysicalUnits = 8.0 );
 SITKCommon_EXPORT std::map< std::string, std::vector< std::string > > ReadParameterFile( const std::string filename );
-SITKCommon_EXPORT void WriteParameterFile( const std::map< std::string, std::vector< std::string > > parameterMap, const std::string filename );
-SITKCommon_EXPORT void PrintParameterMap( const std::map< std::string, std::vector< std::string > > parameterMap );
-SITKCommon_EXPORT void PrintParameterMap( const std::vector< std::map< std::string, std::vector< std::string > > > parameterMapVector );
+SITKCommon_EXPORT void WriteParameterFile( const std::map< std::string, std::vector< std::string > >& parameterMap, const std::string filename );
+SITKCommon_EXPORT void PrintParameterMap( const std::map< std::string, std::vector< std::string > >& parameterMap );
+SITKCommon_EXPORT void PrintParameterMap( const std::vector< std::map< std::string, std::vector< std::string > > >& parameterMapVector );
+
+/** Converts elastix transform parameter maps to an sitk::Transform. Translation,
+ *  Euler, Similarity, Affine and (Recursive)BSpline transforms are supported in
+ *  2D and 3D. Maps in a vector, and initial transform parameter files of the
+ *  first map, are chained into a composite transform. */
+SITKCommon_EXPORT Transform TransformParameterMapToTransform( const std::map< std::string, std::vector< std::string > >& transformParameterMap );
+SITKCommon_EXPORT Transform TransformParameterMapToTransform( const std::vector< std::map< std::string, std::vector< std::string > > >& transformParameterMapVector );
 SITKCommon_EXPORT Image Elastix( const Image& fixedImage, const Image& movingImage, const bool logToConsole = false, const bool logToFile = false, const std::string outputDirectory = "." );
 SITKCommon_EXPORT Image Elastix( const Image& fixedImage, const Image& movingImage, const Image& fixedMask, const Image& movingMask, const bool logToConsole = false, const bool logToFile = false, const std::string outputDirectory = "." );
 SITKCommon_EXPORT Image Elastix( const Image& fixedImage, const Image& movingImage, const std::string defaultParameterMapName, const bool logToConsole = false, const bool logToFile = false, const std::string outputDirectory = "." );
-SITKCommon_EXPORT Image Elastix( const Image& fixedImage, const Image& movingImage, const std::map< std::string, std::vector< std::string > > parameterMap, const bool logToConsole = false, const bool logToFile = false, const std::string outputDirectory = "." );
-SITKCommon_EXPORT Image Elastix( const Image& fixedImage, const Image& movingImage, const std::vector< std::map< std::string, std::vector< std::string > > > parameterMapVector, const bool logToConsole = false, const bool logToFile = false, const std::string outputDirectory = "." );
+SITKCommon_EXPORT Image Elastix( const Image& fixedImage, const Image& movingImage, const std::map< std::string, std::vector< std::string > >& parameterMap, const bool logToConsole = false, const bool logToFile = false, const std::string outputDirectory = "." );
+SITKCommon_EXPORT Image Elastix( const Image& fixedImage, const Image& movingImage, const std::vector< std::map< std::string, std::vector< std::string > > >& parameterMapVector, const bool logToConsole = false, const bool logToFile = false, const std::string outputDirectory = "." );
 SITKCommon_EXPORT Image Elastix( const Image& fixedImage, const Image& movingImage, const std::string defaultParameterMapName, const Image& fixedMask, const Image& movingMask, const bool logToConsole = false, const bool logToFile = false, const std::string outputDirectory = "." );
-SITKCommon_EXPORT Image Elastix( const Image& fixedImage, const Image& movingImage, const std::map< std::string, std::vector< std::string > >, const Image& fixedMask, const Image& movingMask, const bool logToConsole = false, const bool logToFile = false, const std::string outputDirectory = "." );
-SITKCommon_EXPORT Image Elastix( const Image& fixedImage, const Image& movingImage, std::vector< std::map< std::string, std::vector< std::string > > > parameterMapVector, const Image& fixedMask, const Image& movingMask, const bool logToConsole = false, const bool logToFile = false, const std::string outputDirectory = "." );
+SITKCommon_EXPORT Image Elastix( const Image& fixedImage, const Image& movingImage, const std::map< std::string, std::vector< std::string > >& parameterMap, const Image& fixedMask, const Image& movingMask, const bool logToConsole = false, const bool logToFile = false, const std::string outputDirectory = "." );
+SITKCommon_EXPORT Image Elastix( const Image& fixedImage, const Image& movingImage, const std::vector< std::map< std::string, std::vector< std::string > > >& parameterMapVector, const Image& fixedMask, const Image& movingMask, const bool logToConsole = false, const bool logToFile = false, const std::string outputDirectory = "." );
 
 } // end namespace simple
 } // end namespace itk
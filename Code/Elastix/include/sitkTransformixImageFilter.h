@@ -3,11 +3,13 @@
 
 #include "sitkCommon.h"
 #include "sitkImage.h"
+#include "sitkProcessObject.h"
 
 namespace itk { 
   namespace simple {
 
 class SITKCommon_EXPORT TransformixImageFilter
+  : public ProcessObject
 {
   public:
 
@@ -15,6 +17,9 @@ class SITKCommon_EXPORT TransformixImageFilter
     ~TransformixImageFilter( void );
 
     typedef TransformixImageFilter Self;                                
+    typedef ProcessObject Superclass;
+
+    typedef std::vector< Image >                                    VectorOfImage;
 
     typedef std::string                                             ParameterKeyType;
     typedef std::string                                             ParameterValueType;
@@ -25,7 +30,15 @@ class SITKCommon_EXPORT TransformixImageFilter
     typedef ParameterMapType::iterator                              ParameterMapIterator;
     typedef ParameterMapType::const_iterator                        ParameterMapConstIterator;
 
-    const std::string GetName( void );
+    std::string GetName( void ) const;
+
+    /** The number of threads of one Execute(). As transformix only reads the
+     *  process wide ITK and OpenMP defaults, these are set to this value for
+     *  the duration of Execute(). Elastix executions in a process therefore
+     *  run one at a time, and ITK filters created by other threads meanwhile
+     *  also get this number of threads. 0 keeps the defaults. */
+    virtual void SetNumberOfThreads( unsigned int n );
+    virtual unsigned int GetNumberOfThreads( void ) const;
 
     Self& SetMovingImage( const Image& movingImage );
     Image& GetMovingImage( void );
@@ -35,6 +48,12 @@ class SITKCommon_EXPORT TransformixImageFilter
     std::string GetFixedPointSetFileName( void );
     Self& RemoveFixedPointSetFileName( void );
 
+    /** Point set as a flat buffer of physical coordinates (x0, y0, [z0,] x1, y1, [z1,] ...).
+     *  An in-memory point set replaces a point set file name and vice versa. */
+    Self& SetFixedPointSet( const std::vector< double >& fixedPointSet );
+    std::vector< double > GetFixedPointSet( void );
+    Self& RemoveFixedPointSet( void );
+
     Self& SetComputeSpatialJacobian( const bool );
     bool GetComputeSpatialJacobian( void );
     Self& ComputeSpatialJacobianOn( void );
@@ -54,6 +73,21 @@ class SITKCommon_EXPORT TransformixImageFilter
     std::string GetOutputDirectory( void );
     Self& RemoveOutputDirectory( void );
 
+    /** When a result image file name is set, Execute() streams the result
+     *  image to that file instead of returning it. The output grid is split
+     *  into a number of slabs (default 16) that are resampled and written one
+     *  at a time, so only the moving image and one slab are in memory. This
+     *  requires a file format that supports streamed writing, such as
+     *  MetaImage (.mha, .mhd) or NRRD. Other formats are written in one piece.
+     *  Files are written uncompressed. There is no result image in memory
+     *  afterwards, and point sets, deformation fields and spatial Jacobians can not be
+     *  computed at the same time. */
+    Self& SetResultImageFileName( const std::string resultImageFileName );
+    std::string GetResultImageFileName( void );
+    Self& RemoveResultImageFileName( void );
+    Self& SetNumberOfStreamDivisions( const unsigned int numberOfStreamDivisions );
+    unsigned int GetNumberOfStreamDivisions( void );
+
     Self& SetLogFileName( const std::string logFileName );
     std::string GetLogFileName( void );
     Self& RemoveLogFileName( void );
@@ -68,16 +102,16 @@ class SITKCommon_EXPORT TransformixImageFilter
     Self& LogToConsoleOn();
     Self& LogToConsoleOff();
 
-    Self& SetTransformParameterMap( const std::vector< std::map< std::string, std::vector< std::string > > > parameterMapVector );
-    Self& SetTransformParameterMap( const std::map< std::string, std::vector< std::string > > parameterMap );
-    Self& AddTransformParameterMap( const std::map< std::string, std::vector< std::string > > parameterMap );
+    Self& SetTransformParameterMap( const std::vector< std::map< std::string, std::vector< std::string > > >& parameterMapVector );
+    Self& SetTransformParameterMap( const std::map< std::string, std::vector< std::string > >& parameterMap );
+    Self& AddTransformParameterMap( const std::map< std::string, std::vector< std::string > >& parameterMap );
     std::vector< std::map< std::string, std::vector< std::string > > > GetTransformParameterMap( void );
     unsigned int GetNumberOfTransformParameterMaps( void );
 
     Self& SetTransformParameter( const std::string key, const std::string value );
-    Self& SetTransformParameter( const std::string key, const std::vector< std::string > value );
+    Self& SetTransformParameter( const std::string key, const std::vector< std::string >& value );
     Self& SetTransformParameter( const unsigned int index, const std::string key, const std::string value );
-    Self& SetTransformParameter( const unsigned int index, const std::string key, const std::vector< std::string > value );
+    Self& SetTransformParameter( const unsigned int index, const std::string key, const std::vector< std::string >& value );
     Self& AddTransformParameter( const std::string key, const std::string value );
     Self& AddTransformParameter( const unsigned int index, const std::string key, const std::string value );
     std::vector< std::string > GetTransformParameter( const std::string key );
@@ -86,15 +120,47 @@ class SITKCommon_EXPORT TransformixImageFilter
     Self& RemoveTransformParameter( const unsigned int index, const std::string key );
 
     std::map< std::string, std::vector< std::string > > ReadParameterFile( const std::string parameterFileName );
-    Self& WriteParameterFile( const std::map< std::string, std::vector< std::string > > parameterMap, const std::string parameterFileName );
+    Self& WriteParameterFile( const std::map< std::string, std::vector< std::string > >& parameterMap, const std::string parameterFileName );
 
     Self& PrintParameterMap( void );
-    Self& PrintParameterMap( const std::map< std::string, std::vector< std::string > > parameterMap );
-    Self& PrintParameterMap( const std::vector< std::map< std::string, std::vector< std::string > > > parameterMapVector );
+    Self& PrintParameterMap( const std::map< std::string, std::vector< std::string > >& parameterMap );
+    Self& PrintParameterMap( const std::vector< std::map< std::string, std::vector< std::string > > >& parameterMapVector );
 
     Image Execute( void );
 
+    /** Warps each moving image with the same transform parameter maps and
+     *  returns the result images in the same order. Float images are passed to
+     *  transformix without copying. Deformation fields, spatial Jacobians and
+     *  point sets do not depend on the moving image and are computed once. */
+    VectorOfImage Execute( const VectorOfImage& movingImages );
+
+    /** Starts Execute() on a worker thread and returns immediately. Wait()
+     *  blocks until transformix has finished, rethrows its errors and returns
+     *  the result image. IsDone() polls without blocking. Cancel() makes Wait()
+     *  throw and skips a transformation that has not started yet. Other methods
+     *  throw until Wait() has returned. See ElastixImageFilter::ExecuteAsync(). */
+    Self& ExecuteAsync( void );
+    Image Wait( void );
+    bool IsDone( void );
+    Self& Cancel( void );
+
+    /** The result image shares its buffer with the filter. Modifying the
+     *  returned image copies the buffer first unless the filter has released
+     *  it. MoveResultImage() returns the result image and releases the
+     *  filter's reference, so the caller owns the only reference and can modify
+     *  it in place. Afterwards GetResultImage() throws until the next Execute(). */
     Image GetResultImage( void );
+    Image MoveResultImage( void );
+
+    /** Transformed fixed point set in the same flat layout as the input */
+    std::vector< double > GetResultPointSet( void );
+
+    /** Deformation field (vector image), spatial Jacobian (vector image with
+     *  dimension x dimension components in row-major order) and determinant of
+     *  the spatial Jacobian (scalar image) computed by the last Execute() */
+    Image GetDeformationField( void );
+    Image GetSpatialJacobian( void );
+    Image GetDeterminantOfSpatialJacobian( void );
 
   private:
 
@@ -104,8 +170,8 @@ class SITKCommon_EXPORT TransformixImageFilter
 };
 
 // Procedural Interface 
-SITKCommon_EXPORT Image Transformix( const Image& movingImage, const std::map< std::string, std::vector< std::string > > parameterMap, const bool logToConsole = false, const std::string outputDirectory = "." );
-SITKCommon_EXPORT Image Transformix( const Image& movingImage, const std::vector< std::map< std::string, std::vector< std::string > > > parameterMapVector, const bool logToConsole = false, const std::string outputDirectory = "." );
+SITKCommon_EXPORT Image Transformix( const Image& movingImage, const std::map< std::string, std::vector< std::string > >& parameterMap, const bool logToConsole = false, const std::string outputDirectory = "." );
+SITKCommon_EXPORT Image Transformix( const Image& movingImage, const std::vector< std::map< std::string, std::vector< std::string > > >& parameterMapVector, const bool logToConsole = false, const std::string outputDirectory = "." );
 
 } // end namespace simple
 } // end namespace itk
@@ -0,0 +1,165 @@
+#ifndef __sitkelastixasyncexecution_h_
+#define __sitkelastixasyncexecution_h_
+
+#include "sitkMacro.h"
+
+#include "itkMultiThreader.h"
+#include "itkSimpleFastMutexLock.h"
+#include "itkMutexLockHolder.h"
+
+#include <exception>
+#include <string>
+
+namespace itk {
+  namespace simple {
+
+// Elastix and transformix keep process wide state (logging, the component
+// database and the global default number of threads), so only one execution
+// runs at a time in a process. Executions of other filter instances, both
+// synchronous and asynchronous, wait on this lock.
+inline SimpleFastMutexLock& GetElastixExecutionMutex( void )
+{
+  static SimpleFastMutexLock elastixExecutionMutex;
+  return elastixExecutionMutex;
+}
+
+typedef MutexLockHolder< SimpleFastMutexLock > ElastixExecutionLock;
+
+// Runs TOwner::Execute() on a worker thread. Exceptions are caught on the
+// worker thread and rethrown by Wait(). Cancel() only sets a flag: the owner
+// checks it before its execution starts, and a result that finishes after
+// cancellation is discarded, since elastix can not be stopped mid-run.
+template< typename TOwner >
+class AsyncExecution
+{
+public:
+
+  AsyncExecution( TOwner* owner ) : m_Owner( owner ), m_ThreadId( 0 ), m_IsStarted( false ), m_IsDone( false ), m_IsCancelled( false )
+  {
+    this->m_Threader = MultiThreader::New();
+  }
+
+  void Start( void )
+  {
+    // The check and the reset are one step, so that concurrent calls can
+    // not both start an execution
+    {
+      MutexLockHolder< SimpleFastMutexLock > lock( this->m_Mutex );
+      if( this->m_IsStarted )
+      {
+        sitkExceptionMacro( "An asynchronous execution is already running. Call Wait() before starting another one." );
+      }
+
+      this->m_IsStarted = true;
+      this->m_IsDone = false;
+      this->m_IsCancelled = false;
+      this->m_ErrorMessage = "";
+    }
+
+    try
+    {
+      this->m_ThreadId = this->m_Threader->SpawnThread( &AsyncExecution::ThreadCallback, this );
+    }
+    catch( ... )
+    {
+      MutexLockHolder< SimpleFastMutexLock > lock( this->m_Mutex );
+      this->m_IsStarted = false;
+      throw;
+    }
+  }
+
+  // Joins the worker thread. Returns immediately if no execution was started.
+  void Wait( void )
+  {
+    if( !this->IsStarted() )
+    {
+      return;
+    }
+
+    this->m_Threader->TerminateThread( this->m_ThreadId );
+
+    this->m_Mutex.Lock();
+    this->m_IsStarted = false;
+    std::string errorMessage = this->m_ErrorMessage;
+    if( this->m_IsCancelled && errorMessage.empty() )
+    {
+      errorMessage = "Execution was cancelled.";
+    }
+    this->m_Mutex.Unlock();
+
+    if( !errorMessage.empty() )
+    {
+      sitkExceptionMacro( << errorMessage );
+    }
+  }
+
+  bool IsStarted( void )
+  {
+    MutexLockHolder< SimpleFastMutexLock > lock( this->m_Mutex );
+    return this->m_IsStarted;
+  }
+
+  bool IsDone( void )
+  {
+    MutexLockHolder< SimpleFastMutexLock > lock( this->m_Mutex );
+    return this->m_IsDone;
+  }
+
+  void Cancel( void )
+  {
+    MutexLockHolder< SimpleFastMutexLock > lock( this->m_Mutex );
+    this->m_IsCancelled = this->m_IsStarted;
+  }
+
+  // True only while a cancelled asynchronous execution has not been waited for
+  bool IsCancelled( void )
+  {
+    MutexLockHolder< SimpleFastMutexLock > lock( this->m_Mutex );
+    return this->m_IsStarted && this->m_IsCancelled;
+  }
+
+private:
+
+  static ITK_THREAD_RETURN_TYPE ThreadCallback( void* arg )
+  {
+    AsyncExecution* self = static_cast< AsyncExecution* >( static_cast< MultiThreader::ThreadInfoStruct* >( arg )->UserData );
+
+    std::string errorMessage;
+    try
+    {
+      self->m_Owner->Execute();
+    }
+    catch( std::exception& e )
+    {
+      errorMessage = e.what();
+    }
+    catch( ... )
+    {
+      errorMessage = "Unknown exception in asynchronous execution.";
+    }
+
+    self->m_Mutex.Lock();
+    self->m_ErrorMessage = errorMessage;
+    self->m_IsDone = true;
+    self->m_Mutex.Unlock();
+
+    return ITK_THREAD_RETURN_VALUE;
+  }
+
+  AsyncExecution( const AsyncExecution& );
+  void operator=( const AsyncExecution& );
+
+  TOwner*                 m_Owner;
+  MultiThreader::Pointer  m_Threader;
+  ThreadIdType            m_ThreadId;
+  SimpleFastMutexLock     m_Mutex;
+  bool                    m_IsStarted;
+  bool                    m_IsDone;
+  bool                    m_IsCancelled;
+  std::string             m_ErrorMessage;
+};
+
+} // end namespace simple
+} // end namespace itk
+
+#endif // __sitkelastixasyncexecution_h_
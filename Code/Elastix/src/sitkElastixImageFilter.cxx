@@ -8,7 +8,7 @@ namespace itk {
   namespace simple {
 
 ElastixImageFilter
-::ElastixImageFilter( void ) : m_Pimple( new ElastixImageFilterImpl )
+::ElastixImageFilter( void ) : m_Pimple( new ElastixImageFilterImpl( this ) )
 {
 }
 
@@ -19,17 +19,32 @@ ElastixImageFilter
   m_Pimple = NULL;
 }
 
-const std::string 
+std::string 
 ElastixImageFilter
-::GetName( void )
+::GetName( void ) const
 { 
   return this->m_Pimple->GetName();
 }
 
+void
+ElastixImageFilter
+::SetNumberOfThreads( unsigned int n )
+{
+  Superclass::SetNumberOfThreads( n );
+}
+
+unsigned int
+ElastixImageFilter
+::GetNumberOfThreads( void ) const
+{
+  return Superclass::GetNumberOfThreads();
+}
+
 ElastixImageFilter::Self& 
 ElastixImageFilter
 ::SetFixedImage( const Image& fixedImage )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetFixedImage( fixedImage );
   return *this;
 }
@@ -38,6 +53,7 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::SetFixedImage( const VectorOfImage& fixedImages )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetFixedImage( fixedImages );
   return *this;
 }
@@ -46,6 +62,7 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::AddFixedImage( const Image& fixedImage )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->AddFixedImage( fixedImage );
   return *this;
 }
@@ -54,6 +71,7 @@ Image&
 ElastixImageFilter
 ::GetFixedImage( const unsigned long index )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetFixedImage( index );
 }
 
@@ -61,6 +79,7 @@ ElastixImageFilter::VectorOfImage&
 ElastixImageFilter
 ::GetFixedImage( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetFixedImage();
 }
 
@@ -68,6 +87,7 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::RemoveFixedImage( const unsigned long index )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->RemoveFixedImage( index );
   return *this;
 }
@@ -76,6 +96,7 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::RemoveFixedImage( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->RemoveFixedImage();
   return *this;
 }
@@ -84,6 +105,7 @@ unsigned int
 ElastixImageFilter
 ::GetNumberOfFixedImages( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetNumberOfFixedImages();
 }
 
@@ -91,6 +113,7 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::SetMovingImage( const Image& movingImage )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetMovingImage( movingImage );
   return *this;
 }
@@ -99,6 +122,7 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::SetMovingImage( const VectorOfImage& movingImages )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetMovingImage( movingImages );
   return *this;
 }
@@ -107,6 +131,7 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::AddMovingImage( const Image& movingImage )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->AddMovingImage( movingImage );
   return *this;
 }
@@ -115,6 +140,7 @@ Image&
 ElastixImageFilter
 ::GetMovingImage( const unsigned long index )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetMovingImage( index );
 }
 
@@ -122,6 +148,7 @@ ElastixImageFilter::VectorOfImage&
 ElastixImageFilter
 ::GetMovingImage( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetMovingImage();
 }
 
@@ -129,6 +156,7 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::RemoveMovingImage( const unsigned long index )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->RemoveMovingImage( index );
   return *this;
 }
@@ -137,6 +165,7 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::RemoveMovingImage( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->RemoveMovingImage();
   return *this;
 }
@@ -145,6 +174,7 @@ unsigned int
 ElastixImageFilter
 ::GetNumberOfMovingImages( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetNumberOfMovingImages();
 }
 
@@ -152,6 +182,7 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::SetFixedMask( const Image& fixedMask )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetFixedMask( fixedMask );
   return *this;
 }
@@ -160,6 +191,7 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::SetFixedMask( const VectorOfImage& fixedMasks )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetFixedMask( fixedMasks );
   return *this;
 }
@@ -168,6 +200,7 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::AddFixedMask( const Image& fixedMask )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->AddFixedMask( fixedMask );
   return *this;
 }
@@ -176,6 +209,7 @@ Image&
 ElastixImageFilter
 ::GetFixedMask( const unsigned long index )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetFixedMask( index );
 }
 
@@ -183,6 +217,7 @@ ElastixImageFilter::VectorOfImage&
 ElastixImageFilter
 ::GetFixedMask( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetFixedMask();
 }
 
@@ -190,6 +225,7 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::RemoveFixedMask( const unsigned long index )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->RemoveFixedMask( index );
   return *this;
 }
@@ -198,6 +234,7 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::RemoveFixedMask( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->RemoveFixedMask();
   return *this;
 }
@@ -206,6 +243,7 @@ unsigned int
 ElastixImageFilter
 ::GetNumberOfFixedMasks( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetNumberOfFixedMasks();
 }
 
@@ -213,6 +251,7 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::SetMovingMask( const Image& movingMask )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetMovingMask( movingMask );
   return *this;
 }
@@ -221,6 +260,7 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::SetMovingMask( const VectorOfImage& movingMasks )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetMovingMask( movingMasks );
   return *this;
 }
@@ -229,6 +269,7 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::AddMovingMask( const Image& movingMask )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->AddMovingMask( movingMask );
   return *this;
 }
@@ -237,6 +278,7 @@ Image&
 ElastixImageFilter
 ::GetMovingMask( const unsigned long index )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetMovingMask( index );
 }
 
@@ -244,6 +286,7 @@ ElastixImageFilter::VectorOfImage&
 ElastixImageFilter
 ::GetMovingMask( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetMovingMask();
 }
 
@@ -251,6 +294,7 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::RemoveMovingMask( const unsigned long index )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->RemoveMovingMask( index );
   return *this;
 }
@@ -259,6 +303,7 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::RemoveMovingMask( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->RemoveMovingMask();
   return *this;
 }
@@ -267,6 +312,7 @@ unsigned int
 ElastixImageFilter
 ::GetNumberOfMovingMasks( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetNumberOfMovingMasks();
 }
 
@@ -274,6 +320,7 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::SetFixedPointSetFileName( const std::string fixedPointSetFileName )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetFixedPointSetFileName( fixedPointSetFileName );
   return *this;
 }
@@ -282,6 +329,7 @@ std::string
 ElastixImageFilter
 ::GetFixedPointSetFileName( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetFixedPointSetFileName();
 }
 
@@ -289,6 +337,7 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::RemoveFixedPointSetFileName( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->RemoveFixedPointSetFileName();
   return *this;
 }
@@ -297,6 +346,7 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::SetMovingPointSetFileName( const std::string movingPointSetFileName )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetMovingPointSetFileName( movingPointSetFileName );
   return *this;
 }
@@ -305,6 +355,7 @@ std::string
 ElastixImageFilter
 ::GetMovingPointSetFileName( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetMovingPointSetFileName();
 }
 
@@ -312,7 +363,60 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::RemoveMovingPointSetFileName( void )
 {
-  this->m_Pimple->RemoveMovingImage();
+  this->m_Pimple->CheckNotExecutingAsync();
+  this->m_Pimple->RemoveMovingPointSetFileName();
+  return *this;
+}
+
+ElastixImageFilter::Self& 
+ElastixImageFilter
+::SetFixedPointSet( const std::vector< double >& fixedPointSet )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  this->m_Pimple->SetFixedPointSet( fixedPointSet );
+  return *this;
+}
+
+std::vector< double >
+ElastixImageFilter
+::GetFixedPointSet( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  return this->m_Pimple->GetFixedPointSet();
+}
+
+ElastixImageFilter::Self& 
+ElastixImageFilter
+::RemoveFixedPointSet( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  this->m_Pimple->RemoveFixedPointSet();
+  return *this;
+}
+
+ElastixImageFilter::Self& 
+ElastixImageFilter
+::SetMovingPointSet( const std::vector< double >& movingPointSet )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  this->m_Pimple->SetMovingPointSet( movingPointSet );
+  return *this;
+}
+
+std::vector< double >
+ElastixImageFilter
+::GetMovingPointSet( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  return this->m_Pimple->GetMovingPointSet();
+}
+
+ElastixImageFilter::Self& 
+ElastixImageFilter
+::RemoveMovingPointSet( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  this->m_Pimple->RemoveMovingPointSet();
   return *this;
 }
 
@@ -320,6 +424,7 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::SetOutputDirectory( const std::string outputDirectory )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetOutputDirectory( outputDirectory );
   return *this;
 }
@@ -328,6 +433,7 @@ std::string
 ElastixImageFilter
 ::GetOutputDirectory( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetOutputDirectory();
 }
 
@@ -335,6 +441,7 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::RemoveOutputDirectory( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->RemoveOutputDirectory();
   return *this;
 }
@@ -343,6 +450,7 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::SetLogFileName( std::string logFileName )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetLogFileName( logFileName );
   return *this;
 }
@@ -351,6 +459,7 @@ std::string
 ElastixImageFilter
 ::GetLogFileName( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetLogFileName();
 }
 
@@ -358,6 +467,7 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::RemoveLogFileName( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->RemoveLogFileName();
   return *this;
 }
@@ -366,6 +476,7 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::SetLogToFile( bool logToFile )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetLogToFile( logToFile );
   return *this;
 }
@@ -374,6 +485,7 @@ bool
 ElastixImageFilter
 ::GetLogToFile( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetLogToFile();
 }
 
@@ -381,6 +493,7 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::LogToFileOn()
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->LogToFileOn();
   return *this;
 }
@@ -389,6 +502,7 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::LogToFileOff()
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->LogToFileOff();
   return *this;
 }
@@ -397,6 +511,7 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::SetLogToConsole( bool logToConsole )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetLogToConsole( logToConsole );
   return *this;
 }
@@ -405,6 +520,7 @@ bool
 ElastixImageFilter
 ::GetLogToConsole( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetLogToConsole();
 }
 
@@ -412,6 +528,7 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::LogToConsoleOn()
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->LogToConsoleOn();
   return *this;
 }
@@ -420,6 +537,7 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::LogToConsoleOff()
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->LogToConsoleOff();
   return *this;
 }
@@ -428,30 +546,34 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::SetParameterMap( const std::string transformName, const unsigned int numberOfResolutions, const double finalGridSpacingInPhysicalUnits )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetParameterMap( transformName, numberOfResolutions, finalGridSpacingInPhysicalUnits );
   return *this;
 }
 
 ElastixImageFilter::Self& 
 ElastixImageFilter
-::SetParameterMap( const ParameterMapType parameterMap )
+::SetParameterMap( const ParameterMapType& parameterMap )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetParameterMap( parameterMap );
   return *this;
 }
 
 ElastixImageFilter::Self& 
 ElastixImageFilter
-::SetParameterMap( const ParameterMapVectorType parameterMapVector )
+::SetParameterMap( const ParameterMapVectorType& parameterMapVector )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetParameterMap( parameterMapVector );
   return *this;
 }
 
 ElastixImageFilter::Self& 
 ElastixImageFilter
-::AddParameterMap( const ParameterMapType parameterMap )
+::AddParameterMap( const ParameterMapType& parameterMap )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->AddParameterMap( parameterMap );
   return *this;
 }
@@ -460,6 +582,7 @@ ElastixImageFilter::ParameterMapVectorType
 ElastixImageFilter
 ::GetParameterMap( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetParameterMap();
 }
 
@@ -467,6 +590,7 @@ unsigned int
 ElastixImageFilter
 ::GetNumberOfParameterMaps( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetNumberOfParameterMaps();
 }
 
@@ -474,6 +598,7 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::SetInitialTransformParameterFileName( const std::string initialTransformParameterFileName )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetInitialTransformParameterFileName( initialTransformParameterFileName );
   return *this;
 }
@@ -482,6 +607,7 @@ std::string
 ElastixImageFilter
 ::GetInitialTransformParameterFileName( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetInitialTransformParameterFileName();
 }
 
@@ -489,6 +615,7 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::RemoveInitialTransformParameterFileName( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->RemoveInitialTransformParameterFileName();
   return *this;
 }
@@ -497,14 +624,16 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::SetParameter( const ParameterKeyType key, const ParameterValueType value )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetParameter( key, value );
   return *this;
 }
 
 ElastixImageFilter::Self&
 ElastixImageFilter
-::SetParameter( const ParameterKeyType key, const ParameterValueVectorType value )
+::SetParameter( const ParameterKeyType key, const ParameterValueVectorType& value )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetParameter( key, value );
   return *this;
 }
@@ -513,14 +642,16 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::SetParameter( const unsigned int index, const ParameterKeyType key, const ParameterValueType value )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetParameter( index, key, value );
   return *this;
 }
 
 ElastixImageFilter::Self&
 ElastixImageFilter
-::SetParameter( const unsigned int index, const ParameterKeyType key, const ParameterValueVectorType value )
+::SetParameter( const unsigned int index, const ParameterKeyType key, const ParameterValueVectorType& value )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetParameter( index, key, value );
   return *this;
 }
@@ -529,14 +660,16 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::AddParameter( const ParameterKeyType key, const ParameterValueType value )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->AddParameter( key, value );
   return *this;
 }
 
 ElastixImageFilter::Self&
 ElastixImageFilter
-::AddParameter( const ParameterKeyType key, const ParameterValueVectorType value )
+::AddParameter( const ParameterKeyType key, const ParameterValueVectorType& value )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->AddParameter( key, value );
   return *this;
 }
@@ -545,14 +678,16 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::AddParameter( const unsigned int index, const ParameterKeyType key, const ParameterValueType value )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->AddParameter( index, key, value );
   return *this;
 }
 
 ElastixImageFilter::Self&
 ElastixImageFilter
-::AddParameter( const unsigned int index, const ParameterKeyType key, const ParameterValueVectorType value )
+::AddParameter( const unsigned int index, const ParameterKeyType key, const ParameterValueVectorType& value )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->AddParameter( index, key, value );
   return *this;
 }
@@ -561,6 +696,7 @@ ElastixImageFilter::ParameterValueVectorType
 ElastixImageFilter
 ::GetParameter( const ParameterKeyType key )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetParameter( key );
 }
 
@@ -568,6 +704,7 @@ ElastixImageFilter::ParameterValueVectorType
 ElastixImageFilter
 ::GetParameter( const unsigned int index, const ParameterKeyType key )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetParameter( index, key );
 }
 
@@ -575,6 +712,7 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::RemoveParameter( const ParameterKeyType key )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->RemoveParameter( key );
   return *this;
 }
@@ -583,6 +721,7 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::RemoveParameter( const unsigned int index, const ParameterKeyType key )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->RemoveParameter( index, key );
   return *this;
 }
@@ -596,7 +735,7 @@ ElastixImageFilter
 
 ElastixImageFilter::Self&
 ElastixImageFilter
-::WriteParameterFile( ParameterMapType const parameterMap, const std::string parameterFileName )
+::WriteParameterFile( const ParameterMapType& parameterMap, const std::string parameterFileName )
 {
   this->m_Pimple->WriteParameterFile( parameterMap, parameterFileName);
   return *this;
@@ -613,6 +752,7 @@ Image
 ElastixImageFilter
 ::Execute( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->Execute();
 }
 
@@ -620,6 +760,7 @@ ElastixImageFilter::ParameterMapVectorType
 ElastixImageFilter
 ::GetTransformParameterMap( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetTransformParameterMap();
 }
 
@@ -627,6 +768,7 @@ ElastixImageFilter::ParameterMapType
 ElastixImageFilter
 ::GetTransformParameterMap( const unsigned int index )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetTransformParameterMap( index );
 }
 
@@ -634,13 +776,378 @@ Image
 ElastixImageFilter
 ::GetResultImage( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetResultImage();
 }
 
+Image
+ElastixImageFilter
+::MoveResultImage( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  return this->m_Pimple->MoveResultImage();
+}
+
+ElastixImageFilter::Self&
+ElastixImageFilter
+::SetMaximumCacheSize( const uint64_t maximumCacheSize )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  this->m_Pimple->SetMaximumCacheSize( maximumCacheSize );
+  return *this;
+}
+
+uint64_t
+ElastixImageFilter
+::GetMaximumCacheSize( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  return this->m_Pimple->GetMaximumCacheSize();
+}
+
+uint64_t
+ElastixImageFilter
+::GetCacheSize( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  return this->m_Pimple->GetCacheSize();
+}
+
+ElastixImageFilter::Self&
+ElastixImageFilter
+::ClearCache( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  this->m_Pimple->ClearCache();
+  return *this;
+}
+
+ElastixImageFilter::Self&
+ElastixImageFilter
+::SetMaximumNumberOfCachedResults( const unsigned int maximumNumberOfCachedResults )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  this->m_Pimple->SetMaximumNumberOfCachedResults( maximumNumberOfCachedResults );
+  return *this;
+}
+
+unsigned int
+ElastixImageFilter
+::GetMaximumNumberOfCachedResults( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  return this->m_Pimple->GetMaximumNumberOfCachedResults();
+}
+
+unsigned int
+ElastixImageFilter
+::GetNumberOfCachedResults( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  return this->m_Pimple->GetNumberOfCachedResults();
+}
+
+ElastixImageFilter::Self&
+ElastixImageFilter
+::ClearResultCache( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  this->m_Pimple->ClearResultCache();
+  return *this;
+}
+
+ElastixImageFilter::Self&
+ElastixImageFilter
+::SetResultCacheDirectory( const std::string resultCacheDirectory )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  this->m_Pimple->SetResultCacheDirectory( resultCacheDirectory );
+  return *this;
+}
+
+std::string
+ElastixImageFilter
+::GetResultCacheDirectory( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  return this->m_Pimple->GetResultCacheDirectory();
+}
+
+ElastixImageFilter::Self&
+ElastixImageFilter
+::RemoveResultCacheDirectory( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  this->m_Pimple->RemoveResultCacheDirectory();
+  return *this;
+}
+
+ElastixImageFilter::Self&
+ElastixImageFilter
+::SetCropToMasks( const bool cropToMasks )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  this->m_Pimple->SetCropToMasks( cropToMasks );
+  return *this;
+}
+
+bool
+ElastixImageFilter
+::GetCropToMasks( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  return this->m_Pimple->GetCropToMasks();
+}
+
+ElastixImageFilter::Self&
+ElastixImageFilter
+::CropToMasksOn( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  this->m_Pimple->CropToMasksOn();
+  return *this;
+}
+
+ElastixImageFilter::Self&
+ElastixImageFilter
+::CropToMasksOff( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  this->m_Pimple->CropToMasksOff();
+  return *this;
+}
+
+ElastixImageFilter::Self&
+ElastixImageFilter
+::SetCropToMasksPadding( const unsigned int cropToMasksPadding )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  this->m_Pimple->SetCropToMasksPadding( cropToMasksPadding );
+  return *this;
+}
+
+unsigned int
+ElastixImageFilter
+::GetCropToMasksPadding( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  return this->m_Pimple->GetCropToMasksPadding();
+}
+
+ElastixImageFilter::Self&
+ElastixImageFilter
+::SetRandomSeed( const unsigned int randomSeed )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  this->m_Pimple->SetRandomSeed( randomSeed );
+  return *this;
+}
+
+unsigned int
+ElastixImageFilter
+::GetRandomSeed( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  return this->m_Pimple->GetRandomSeed();
+}
+
+bool
+ElastixImageFilter
+::HasRandomSeed( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  return this->m_Pimple->HasRandomSeed();
+}
+
+ElastixImageFilter::Self&
+ElastixImageFilter
+::RemoveRandomSeed( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  this->m_Pimple->RemoveRandomSeed();
+  return *this;
+}
+
+ElastixImageFilter::Self&
+ElastixImageFilter
+::SetLowMemoryMode( const bool lowMemoryMode )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  this->m_Pimple->SetLowMemoryMode( lowMemoryMode );
+  return *this;
+}
+
+bool
+ElastixImageFilter
+::GetLowMemoryMode( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  return this->m_Pimple->GetLowMemoryMode();
+}
+
+ElastixImageFilter::Self&
+ElastixImageFilter
+::LowMemoryModeOn( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  this->m_Pimple->LowMemoryModeOn();
+  return *this;
+}
+
+ElastixImageFilter::Self&
+ElastixImageFilter
+::LowMemoryModeOff( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  this->m_Pimple->LowMemoryModeOff();
+  return *this;
+}
+
+uint64_t
+ElastixImageFilter
+::GetPeakMemoryUsage( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  return this->m_Pimple->GetPeakMemoryUsage();
+}
+
+ElastixImageFilter::Self&
+ElastixImageFilter
+::SetUseNativePixelType( const bool useNativePixelType )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  this->m_Pimple->SetUseNativePixelType( useNativePixelType );
+  return *this;
+}
+
+bool
+ElastixImageFilter
+::GetUseNativePixelType( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  return this->m_Pimple->GetUseNativePixelType();
+}
+
+ElastixImageFilter::Self&
+ElastixImageFilter
+::UseNativePixelTypeOn( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  this->m_Pimple->UseNativePixelTypeOn();
+  return *this;
+}
+
+ElastixImageFilter::Self&
+ElastixImageFilter
+::UseNativePixelTypeOff( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  this->m_Pimple->UseNativePixelTypeOff();
+  return *this;
+}
+
+ElastixImageFilter::Self&
+ElastixImageFilter
+::SetRecordIterationInfo( const bool recordIterationInfo )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  this->m_Pimple->SetRecordIterationInfo( recordIterationInfo );
+  return *this;
+}
+
+bool
+ElastixImageFilter
+::GetRecordIterationInfo( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  return this->m_Pimple->GetRecordIterationInfo();
+}
+
+ElastixImageFilter::Self&
+ElastixImageFilter
+::RecordIterationInfoOn( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  this->m_Pimple->RecordIterationInfoOn();
+  return *this;
+}
+
+ElastixImageFilter::Self&
+ElastixImageFilter
+::RecordIterationInfoOff( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  this->m_Pimple->RecordIterationInfoOff();
+  return *this;
+}
+
+std::map< std::string, std::vector< double > >
+ElastixImageFilter
+::GetIterationInfo( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  return this->m_Pimple->GetIterationInfo();
+}
+
+Transform
+ElastixImageFilter
+::GetTransform( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  return TransformParameterMapToTransform( this->m_Pimple->GetTransformParameterMap() );
+}
+
+ElastixImageFilter::Self&
+ElastixImageFilter
+::ExecuteAsync( void )
+{
+  this->m_Pimple->ExecuteAsync();
+  return *this;
+}
+
+Image
+ElastixImageFilter
+::Wait( void )
+{
+  return this->m_Pimple->Wait();
+}
+
+bool
+ElastixImageFilter
+::IsDone( void )
+{
+  return this->m_Pimple->IsDone();
+}
+
+ElastixImageFilter::Self&
+ElastixImageFilter
+::Cancel( void )
+{
+  this->m_Pimple->Cancel();
+  return *this;
+}
+
+ElastixImageFilter::VectorOfImage
+ElastixImageFilter
+::ExecuteBatch( const Image& fixedImage, const VectorOfImage& movingImages )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  return this->m_Pimple->ExecuteBatch( fixedImage, movingImages );
+}
+
+std::vector< ElastixImageFilter::ParameterMapVectorType >
+ElastixImageFilter
+::GetBatchTransformParameterMap( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  return this->m_Pimple->GetBatchTransformParameterMap();
+}
+
 ElastixImageFilter::ParameterMapVectorType
 ElastixImageFilter
 ::ExecuteInverse( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->ExecuteInverse();
 }
 
@@ -648,6 +1155,7 @@ ElastixImageFilter::ParameterMapVectorType
 ElastixImageFilter
 ::ExecuteInverse( std::map< std::string, std::vector< std::string > > inverseParameterMap )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->ExecuteInverse( ParameterMapVectorType( 1, inverseParameterMap ) );
 }
 
@@ -655,6 +1163,7 @@ ElastixImageFilter::ParameterMapVectorType
 ElastixImageFilter
 ::ExecuteInverse( std::vector< std::map< std::string, std::vector< std::string > > > inverseParameterMapVector )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->ExecuteInverse( inverseParameterMapVector );
 }
 
@@ -662,6 +1171,7 @@ ElastixImageFilter::ParameterMapVectorType
 ElastixImageFilter
 ::GetInverseTransformParameterMap( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetInverseTransformParameterMap();
 }
 
@@ -669,13 +1179,14 @@ ElastixImageFilter::Self&
 ElastixImageFilter
 ::PrintParameterMap( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->PrintParameterMap();
   return *this;
 }
 
 ElastixImageFilter::Self&
 ElastixImageFilter
-::PrintParameterMap( const ParameterMapType parameterMap )
+::PrintParameterMap( const ParameterMapType& parameterMap )
 {
   this->m_Pimple->PrintParameterMap( parameterMap );
   return *this;
@@ -683,7 +1194,7 @@ ElastixImageFilter
 
 ElastixImageFilter::Self&
 ElastixImageFilter
-::PrintParameterMap( const ParameterMapVectorType parameterMapVector )
+::PrintParameterMap( const ParameterMapVectorType& parameterMapVector )
 {
   this->m_Pimple->PrintParameterMap( parameterMapVector );
   return *this;
@@ -710,21 +1221,21 @@ ReadParameterFile( const std::string fileName )
 }
 
 void
-WriteParameterFile( const ElastixImageFilter::ParameterMapType parameterMap, const std::string filename )
+WriteParameterFile( const ElastixImageFilter::ParameterMapType& parameterMap, const std::string filename )
 {
   ElastixImageFilter selx;
   selx.WriteParameterFile( parameterMap, filename );
 }
 
 void
-PrintParameterMap( const ElastixImageFilter::ParameterMapType parameterMap )
+PrintParameterMap( const ElastixImageFilter::ParameterMapType& parameterMap )
 {
   ElastixImageFilter::ParameterMapVectorType parameterMapVector = ElastixImageFilter::ParameterMapVectorType( 1, parameterMap );
   PrintParameterMap( parameterMapVector );
 }
 
 void
-PrintParameterMap( const ElastixImageFilter::ParameterMapVectorType parameterMapVector )
+PrintParameterMap( const ElastixImageFilter::ParameterMapVectorType& parameterMapVector )
 {
   ElastixImageFilter selx;
   selx.SetParameterMap( parameterMapVector );
@@ -766,14 +1277,14 @@ Elastix( const Image& fixedImage, const Image& movingImage, const std::string de
 }
 
 Image
-Elastix( const Image& fixedImage, const Image& movingImage, const ElastixImageFilter::ParameterMapType parameterMap, const bool logToConsole, const bool logToFile, const std::string outputDirectory )
+Elastix( const Image& fixedImage, const Image& movingImage, const ElastixImageFilter::ParameterMapType& parameterMap, const bool logToConsole, const bool logToFile, const std::string outputDirectory )
 {
   ElastixImageFilter::ParameterMapVectorType parameterMapVector = ElastixImageFilter::ParameterMapVectorType( 1, parameterMap );
   return Elastix( fixedImage, movingImage, parameterMapVector, logToConsole, logToFile, outputDirectory );
 }
 
 Image
-Elastix( const Image& fixedImage, const Image& movingImage, const ElastixImageFilter::ParameterMapVectorType parameterMapVector, const bool logToConsole, const bool logToFile, const std::string outputDirectory )
+Elastix( const Image& fixedImage, const Image& movingImage, const ElastixImageFilter::ParameterMapVectorType& parameterMapVector, const bool logToConsole, const bool logToFile, const std::string outputDirectory )
 {
   ElastixImageFilter selx;
   selx.SetFixedImage( fixedImage );
@@ -793,14 +1304,14 @@ Elastix( const Image& fixedImage, const Image& movingImage, const std::string de
 }
 
 Image
-Elastix( const Image& fixedImage, const Image& movingImage, const ElastixImageFilter::ParameterMapType parameterMap, const Image& fixedMask, const Image& movingMask, bool logToConsole, const bool logToFile, std::string outputDirectory )
+Elastix( const Image& fixedImage, const Image& movingImage, const ElastixImageFilter::ParameterMapType& parameterMap, const Image& fixedMask, const Image& movingMask, bool logToConsole, const bool logToFile, std::string outputDirectory )
 {
   ElastixImageFilter::ParameterMapVectorType parameterMapVector = ElastixImageFilter::ParameterMapVectorType( 1, parameterMap );
   return Elastix( fixedImage, movingImage, parameterMapVector, fixedMask, movingMask, logToConsole, logToFile, outputDirectory );
 }
 
 Image
-Elastix( const Image& fixedImage, const Image& movingImage, ElastixImageFilter::ParameterMapVectorType parameterMapVector, const Image& fixedMask, const Image& movingMask, bool logToConsole, const bool logToFile, std::string outputDirectory )
+Elastix( const Image& fixedImage, const Image& movingImage, const ElastixImageFilter::ParameterMapVectorType& parameterMapVector, const Image& fixedMask, const Image& movingMask, bool logToConsole, const bool logToFile, std::string outputDirectory )
 {
   ElastixImageFilter selx;
   selx.SetFixedImage( fixedImage );
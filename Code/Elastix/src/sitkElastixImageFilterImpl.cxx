@@ -4,20 +4,222 @@
 #include "sitkElastixImageFilter.h"
 #include "sitkElastixImageFilterImpl.h"
 #include "sitkCastImageFilter.h"
+#include "sitkHashImageFilter.h"
+#include "sitkNotEqualImageFilter.h"
+#include "sitkAdditionalProcedures.h"
+#include "sitkImageFileReader.h"
+#include "sitkImageFileWriter.h"
+#include "sitkNumberOfThreadsGuard.h"
+#include "sitkElastixTemporaryFiles.h"
+#include "sitkElastixMemoryUsage.h"
+
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkRegionOfInterestImageFilter.h"
+
+#include <itksys/MD5.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
 
 namespace itk {
   namespace simple {
 
+namespace {
+
+// Registers member functions for fixed and moving images of the same pixel type
+// only, since elastix is compiled for these combinations only
+template< typename TMemberFunctionFactory, unsigned int VImageDimension >
+struct SamePixelTypeMemberFunctionRegister
+{
+  SamePixelTypeMemberFunctionRegister( TMemberFunctionFactory& factory ) : m_Factory( factory ) {}
+
+  template< class TPixelIDType >
+  void operator()( void ) const
+  {
+    typedef typename typelist::MakeTypeList< TPixelIDType >::Type PixelIDTypeList;
+    this->m_Factory.template RegisterMemberFunctions< PixelIDTypeList, PixelIDTypeList, VImageDimension >();
+  }
+
+  TMemberFunctionFactory& m_Factory;
+};
+
+// Appends the content hash and geometry of an image to a result cache key
+void AppendImageToKey( std::ostream& key, const std::string& name, const Image& image )
+{
+  key << name << " " << Hash( image ) << " " << image.GetPixelID() << " " << image.GetNumberOfComponentsPerPixel();
+  const std::vector< unsigned int > size = image.GetSize();
+  const std::vector< double > origin = image.GetOrigin();
+  const std::vector< double > spacing = image.GetSpacing();
+  const std::vector< double > direction = image.GetDirection();
+  for( unsigned int i = 0; i < size.size(); ++i )
+  {
+    key << " " << size[ i ] << " " << origin[ i ] << " " << spacing[ i ];
+  }
+  for( unsigned int i = 0; i < direction.size(); ++i )
+  {
+    key << " " << direction[ i ];
+  }
+  key << "\n";
+}
+
+// Appends the content of a file to a result cache key, so that a changed file
+// with the same name does not hit the cache
+void AppendFileToKey( std::ostream& key, const std::string& name, const std::string& fileName )
+{
+  key << name << " " << fileName << "\n";
+  if( !fileName.empty() && itksys::SystemTools::FileExists( fileName.c_str(), true ) )
+  {
+    std::ifstream file( fileName.c_str() );
+    if( file.peek() != std::ifstream::traits_type::eof() )
+    {
+      key << file.rdbuf();
+    }
+    key << "\n";
+  }
+}
+
+std::string MD5Hex( const std::string& data )
+{
+  itksysMD5* md5 = itksysMD5_New();
+  itksysMD5_Initialize( md5 );
+  itksysMD5_Append( md5, reinterpret_cast< const unsigned char* >( data.c_str() ), static_cast< int >( data.size() ) );
+  char digest[ 33 ];
+  itksysMD5_FinalizeHex( md5, digest );
+  digest[ 32 ] = '\0';
+  itksysMD5_Delete( md5 );
+  return std::string( digest );
+}
+
+// Elastix treats nonzero mask voxels as inside, so masks of any integer
+// pixel type can be converted to its unsigned char masks
+bool IsIntegerPixelID( const PixelIDValueEnum pixelID )
+{
+  return pixelID == sitkUInt8 || pixelID == sitkInt8
+      || pixelID == sitkUInt16 || pixelID == sitkInt16
+      || pixelID == sitkUInt32 || pixelID == sitkInt32
+      || pixelID == sitkUInt64 || pixelID == sitkInt64;
+}
+
+// Expands a physical bounding box [lower, upper] by the nonzero voxels of a mask
+template< typename TMask >
+void ExpandPhysicalBoundingBox( const TMask* mask, std::vector< double >& lower, std::vector< double >& upper )
+{
+  const unsigned int Dimension = TMask::ImageDimension;
+
+  typename TMask::IndexType minIndex;
+  typename TMask::IndexType maxIndex;
+  bool isEmpty = true;
+
+  ImageRegionConstIteratorWithIndex< TMask > it( mask, mask->GetBufferedRegion() );
+  for( it.GoToBegin(); !it.IsAtEnd(); ++it )
+  {
+    if( it.Get() != 0 )
+    {
+      const typename TMask::IndexType index = it.GetIndex();
+      for( unsigned int d = 0; d < Dimension; ++d )
+      {
+        minIndex[ d ] = isEmpty ? index[ d ] : std::min( minIndex[ d ], index[ d ] );
+        maxIndex[ d ] = isEmpty ? index[ d ] : std::max( maxIndex[ d ], index[ d ] );
+      }
+      isEmpty = false;
+    }
+  }
+
+  if( isEmpty )
+  {
+    return;
+  }
+
+  // Corners of the voxels at the boundary of the box, in any orientation
+  for( unsigned int corner = 0; corner < ( 1u << Dimension ); ++corner )
+  {
+    ContinuousIndex< double, Dimension > index;
+    for( unsigned int d = 0; d < Dimension; ++d )
+    {
+      index[ d ] = corner & ( 1u << d ) ? maxIndex[ d ] + 0.5 : minIndex[ d ] - 0.5;
+    }
+
+    typename TMask::PointType point;
+    mask->TransformContinuousIndexToPhysicalPoint( index, point );
+    for( unsigned int d = 0; d < Dimension; ++d )
+    {
+      lower[ d ] = std::min( lower[ d ], point[ d ] );
+      upper[ d ] = std::max( upper[ d ], point[ d ] );
+    }
+  }
+}
+
+// Crops an image to the voxels inside a physical bounding box, padded by a
+// number of voxels. The cropped image keeps its physical position, so
+// transforms estimated on it are valid for the full image.
+template< typename TImage >
+typename TImage::Pointer CropToPhysicalBoundingBox( TImage* image, const std::vector< double >& lower, const std::vector< double >& upper, const unsigned int padding )
+{
+  const unsigned int Dimension = TImage::ImageDimension;
+
+  if( lower[ 0 ] > upper[ 0 ] )
+  {
+    return image;
+  }
+
+  std::vector< double > minIndex( Dimension, std::numeric_limits< double >::max() );
+  std::vector< double > maxIndex( Dimension, -std::numeric_limits< double >::max() );
+  for( unsigned int corner = 0; corner < ( 1u << Dimension ); ++corner )
+  {
+    typename TImage::PointType point;
+    for( unsigned int d = 0; d < Dimension; ++d )
+    {
+      point[ d ] = corner & ( 1u << d ) ? upper[ d ] : lower[ d ];
+    }
+
+    ContinuousIndex< double, Dimension > index;
+    image->TransformPhysicalPointToContinuousIndex( point, index );
+    for( unsigned int d = 0; d < Dimension; ++d )
+    {
+      minIndex[ d ] = std::min( minIndex[ d ], index[ d ] );
+      maxIndex[ d ] = std::max( maxIndex[ d ], index[ d ] );
+    }
+  }
+
+  typename TImage::RegionType region;
+  for( unsigned int d = 0; d < Dimension; ++d )
+  {
+    const IndexValueType first = static_cast< IndexValueType >( std::floor( minIndex[ d ] + 0.5 ) ) - padding;
+    const IndexValueType last = static_cast< IndexValueType >( std::ceil( maxIndex[ d ] - 0.5 ) ) + padding;
+    region.SetIndex( d, first );
+    region.SetSize( d, last >= first ? static_cast< SizeValueType >( last - first + 1 ) : 0 );
+  }
+
+  if( !region.Crop( image->GetLargestPossibleRegion() ) || region == image->GetLargestPossibleRegion() )
+  {
+    return image;
+  }
+
+  typedef RegionOfInterestImageFilter< TImage, TImage > RegionOfInterestImageFilterType;
+  typename RegionOfInterestImageFilterType::Pointer regionOfInterestImageFilter = RegionOfInterestImageFilterType::New();
+  regionOfInterestImageFilter->SetInput( image );
+  regionOfInterestImageFilter->SetRegionOfInterest( region );
+  regionOfInterestImageFilter->Update();
+  return regionOfInterestImageFilter->GetOutput();
+}
+
+} // end anonymous namespace
+
 ElastixImageFilter::ElastixImageFilterImpl
-::ElastixImageFilterImpl( void )
+::ElastixImageFilterImpl( ElastixImageFilter* elastixImageFilter ) : m_ElastixImageFilter( elastixImageFilter ), m_AsyncExecution( this )
 {
+  typedef detail::DualMemberFunctionFactory< MemberFunctionType > DualMemberFunctionFactoryType;
+
   // Register this class with SimpleITK
-  this->m_DualMemberFactory.reset( new detail::DualMemberFunctionFactory< MemberFunctionType >( this ) );
-  this->m_DualMemberFactory->RegisterMemberFunctions< FloatPixelIDTypeList, FloatPixelIDTypeList, 2 >();
-  this->m_DualMemberFactory->RegisterMemberFunctions< FloatPixelIDTypeList, FloatPixelIDTypeList, 3 >();
+  this->m_DualMemberFactory.reset( new DualMemberFunctionFactoryType( this ) );
+
+  typelist::Visit< ElastixPixelIDTypeList > visitEachPixelType;
+  visitEachPixelType( SamePixelTypeMemberFunctionRegister< DualMemberFunctionFactoryType, 2 >( *this->m_DualMemberFactory ) );
+  visitEachPixelType( SamePixelTypeMemberFunctionRegister< DualMemberFunctionFactoryType, 3 >( *this->m_DualMemberFactory ) );
 
 #ifdef SITK_4D_IMAGES
-  this->m_DualMemberFactory->RegisterMemberFunctions< FloatPixelIDTypeList, FloatPixelIDTypeList, 4 >();
+  visitEachPixelType( SamePixelTypeMemberFunctionRegister< DualMemberFunctionFactoryType, 4 >( *this->m_DualMemberFactory ) );
 #endif
  
   m_FixedImages                 = VectorOfImage();
@@ -31,13 +233,34 @@ ElastixImageFilter::ElastixImageFilterImpl
 
   m_FixedPointSetFileName       = "";
   m_MovingPointSetFileName      = "";
+  m_FixedPointSet               = std::vector< double >();
+  m_MovingPointSet              = std::vector< double >();
 
   m_OutputDirectory             = ".";
+  m_IsOutputDirectorySet        = false;
   m_LogFileName                 = "";
 
   this->m_LogToFile = false;
   this->m_LogToConsole = true;
 
+  this->m_CacheSize = 0;
+  this->m_MaximumCacheSize = 0;
+
+  this->m_RecordIterationInfo = false;
+
+  this->m_CropToMasks = false;
+  this->m_CropToMasksPadding = 8;
+
+  this->m_MaximumNumberOfCachedResults = 0;
+
+  this->m_LowMemoryMode = false;
+  this->m_PeakMemoryUsage = 0;
+
+  this->m_UseNativePixelType = false;
+
+  this->m_RandomSeed = 0;
+  this->m_IsRandomSeedSet = false;
+
   ParameterMapVectorType defaultParameterMap;
   defaultParameterMap.push_back( ParameterObjectType::GetDefaultParameterMap( "translation" ) );
   defaultParameterMap.push_back( ParameterObjectType::GetDefaultParameterMap( "affine" ) );
@@ -48,6 +271,15 @@ ElastixImageFilter::ElastixImageFilterImpl
 ElastixImageFilter::ElastixImageFilterImpl
 ::~ElastixImageFilterImpl( void )
 {
+  // The worker thread uses this object, so it must finish first
+  this->m_AsyncExecution.Cancel();
+  try
+  {
+    this->m_AsyncExecution.Wait();
+  }
+  catch( ... )
+  {
+  }
 }
 
 
@@ -112,25 +344,78 @@ ElastixImageFilter::ElastixImageFilterImpl
 
   for( unsigned int i = 0; i < this->GetNumberOfFixedMasks(); ++i )
   {
-    if( this->GetFixedMask( i ).GetPixelID() != sitkUInt8 )
+    if( !IsIntegerPixelID( this->GetFixedMask( i ).GetPixelID() ) )
     {
-      sitkExceptionMacro( "Fixed mask must be of pixel type unsigned char (fixed mask at index " 
+      sitkExceptionMacro( "Fixed mask must be of an integer pixel type (fixed mask at index " 
                        << i << " is of type \"" << GetPixelIDValueAsElastixParameter( this->GetFixedMask( i ).GetPixelID() ) << "\")." );
     }
   }
 
   for( unsigned int i = 0; i < this->GetNumberOfMovingMasks(); ++i )
   {
-    if( this->GetMovingMask( i ).GetPixelID() != sitkUInt8 )
+    if( !IsIntegerPixelID( this->GetMovingMask( i ).GetPixelID() ) )
     {
-      sitkExceptionMacro( "Moving mask must be of pixel type unsigned char (moving mask at index " 
+      sitkExceptionMacro( "Moving mask must be of an integer pixel type (moving mask at index " 
                        << i << " is of type \"" << GetPixelIDValueAsElastixParameter( this->GetMovingMask( i ).GetPixelID() ) << "\")." );
     }
   }
 
+  // The result image of a registration on a cropped fixed image is resampled onto
+  // the full fixed image. This needs transforms that are valid outside the crop,
+  // which a B-spline control point grid over the crop only is not.
+  if( this->GetCropToMasks() && this->GetNumberOfFixedMasks() > 0 )
+  {
+    for( unsigned int i = 0; i < this->m_ParameterMapVector.size(); ++i )
+    {
+      ParameterMapConstIterator it = this->m_ParameterMapVector[ i ].find( "Transform" );
+      const std::string transformName = it != this->m_ParameterMapVector[ i ].end() && !it->second.empty() ? it->second[ 0 ] : "";
+      if( transformName != "TranslationTransform" && transformName != "EulerTransform"
+        && transformName != "SimilarityTransform" && transformName != "AffineTransform" )
+      {
+        sitkExceptionMacro( "Cropping to fixed masks does not support \"" << transformName << "\" (parameter map at index " << i << "). "
+                         << "Supported transforms are TranslationTransform, EulerTransform, SimilarityTransform and AffineTransform." );
+      }
+    }
+  }
+
+  // Identical inputs and parameter maps give identical results
+  std::string resultCacheKey;
+  if( this->GetMaximumNumberOfCachedResults() > 0 || !this->GetResultCacheDirectory().empty() )
+  {
+    resultCacheKey = this->GetResultCacheKey();
+    if( this->FindCachedResult( resultCacheKey ) )
+    {
+      return this->m_ResultImage;
+    }
+  }
+
+  // With native pixel types, images are registered without casting if all fixed and
+  // moving images share a pixel type that elastix is compiled with. Otherwise they
+  // are casted to float.
+  bool isSamePixelType = this->IsNativePixelTypeEnabled() && FixedImagePixelID == MovingImagePixelID;
+
+  for( unsigned int i = 1; i < this->GetNumberOfFixedImages(); ++i )
+  {
+    isSamePixelType = isSamePixelType && this->GetFixedImage( i ).GetPixelID() == FixedImagePixelID;
+  }
+
+  for( unsigned int i = 1; i < this->GetNumberOfMovingImages(); ++i )
+  {
+    isSamePixelType = isSamePixelType && this->GetMovingImage( i ).GetPixelID() == MovingImagePixelID;
+  }
+
+  if( isSamePixelType && this->m_DualMemberFactory->HasMemberFunction( FixedImagePixelID, MovingImagePixelID, FixedImageDimension ) )
+  {
+    this->m_DualMemberFactory->GetMemberFunction( FixedImagePixelID, MovingImagePixelID, FixedImageDimension )();
+    this->AddCachedResult( resultCacheKey );
+    return this->m_ResultImage;
+  }
+
   if( this->m_DualMemberFactory->HasMemberFunction( sitkFloat32, sitkFloat32, FixedImageDimension ) )
   {
-    return this->m_DualMemberFactory->GetMemberFunction( sitkFloat32, sitkFloat32, FixedImageDimension )();
+    this->m_DualMemberFactory->GetMemberFunction( sitkFloat32, sitkFloat32, FixedImageDimension )();
+    this->AddCachedResult( resultCacheKey );
+    return this->m_ResultImage;
   }
 
   sitkExceptionMacro( << "ElastixImageFilter does not support the combination of "
@@ -153,55 +438,186 @@ ElastixImageFilter::ElastixImageFilterImpl
 
   try
   {
+    ElastixExecutionLock elastixExecutionLock( GetElastixExecutionMutex() );
+
+    if( this->m_AsyncExecution.IsCancelled() )
+    {
+      sitkExceptionMacro( "Registration was cancelled." );
+    }
+
+    // Scope the thread budget of this filter to this execution
+    NumberOfThreadsGuard numberOfThreadsGuard( elastixExecutionLock, this->m_ElastixImageFilter->GetNumberOfThreads() );
+
+    // Executions are serialized, so the peak covers this execution only
+    PeakMemoryMonitor peakMemoryMonitor;
+
     ElastixFilterPointer elastixFilter = ElastixFilterType::New();
 
-    for( unsigned int i = 0; i < this->GetNumberOfFixedImages(); ++i )
+    // Masks are sampled at physical points and are not cropped
+    std::vector< double > fixedLower( TFixedImage::ImageDimension, std::numeric_limits< double >::max() );
+    std::vector< double > fixedUpper( TFixedImage::ImageDimension, -std::numeric_limits< double >::max() );
+    for( unsigned int i = 0; i < this->GetNumberOfFixedMasks(); ++i )
     {
-      elastixFilter->AddFixedImage( itkDynamicCastInDebugMode< TFixedImage* >( Cast( this->GetFixedImage( i ), sitkFloat32 ).GetITKBase() ) );
+      typename FixedMaskType::Pointer fixedMask = this->GetITKMask< FixedMaskType >( this->GetFixedMask( i ) );
+      if( this->GetCropToMasks() )
+      {
+        ExpandPhysicalBoundingBox( fixedMask, fixedLower, fixedUpper );
+      }
+      elastixFilter->AddFixedMask( fixedMask );
     }
 
-    for( unsigned int i = 0; i < this->GetNumberOfMovingImages(); ++i )
+    std::vector< double > movingLower( TMovingImage::ImageDimension, std::numeric_limits< double >::max() );
+    std::vector< double > movingUpper( TMovingImage::ImageDimension, -std::numeric_limits< double >::max() );
+    for( unsigned int i = 0; i < this->GetNumberOfMovingMasks(); ++i )
     {
-      elastixFilter->AddMovingImage( itkDynamicCastInDebugMode< TMovingImage* >( Cast( this->GetMovingImage( i ), sitkFloat32 ).GetITKBase() ) );
+      typename MovingMaskType::Pointer movingMask = this->GetITKMask< MovingMaskType >( this->GetMovingMask( i ) );
+      if( this->GetCropToMasks() )
+      {
+        ExpandPhysicalBoundingBox( movingMask, movingLower, movingUpper );
+      }
+      elastixFilter->AddMovingMask( movingMask );
     }
 
-    for( unsigned int i = 0; i < this->GetNumberOfFixedMasks(); ++i )
+    // Bounding boxes are empty unless cropping is on and masks are set, in
+    // which case images are registered on the padded bounding box of the masks
+    bool isFixedImageCropped = false;
+    std::vector< typename TFixedImage::Pointer > fixedImages;
+    for( unsigned int i = 0; i < this->GetNumberOfFixedImages(); ++i )
     {
-      elastixFilter->AddFixedMask( itkDynamicCastInDebugMode< FixedMaskType* >( this->GetFixedMask( i ).GetITKBase() ) );
+      // A cached cast outlives the execution, so it is not kept in low memory mode
+      typename TFixedImage::Pointer fixedImage = this->GetLowMemoryMode()
+                                               ? this->GetITKImage< TFixedImage >( this->GetFixedImage( i ) )
+                                               : this->GetCachedITKImage< TFixedImage >( this->GetFixedImage( i ) );
+      fixedImages.push_back( fixedImage );
+      typename TFixedImage::Pointer croppedFixedImage = CropToPhysicalBoundingBox< TFixedImage >( fixedImage, fixedLower, fixedUpper, this->GetCropToMasksPadding() );
+      isFixedImageCropped = isFixedImageCropped || croppedFixedImage != fixedImage;
+      elastixFilter->AddFixedImage( croppedFixedImage );
     }
 
-    for( unsigned int i = 0; i < this->GetNumberOfMovingMasks(); ++i )
+    for( unsigned int i = 0; i < this->GetNumberOfMovingImages(); ++i )
     {
-      elastixFilter->AddMovingMask( itkDynamicCastInDebugMode< MovingMaskType* >( this->GetMovingMask( i ).GetITKBase() ) );
+      // Groupwise registrations pass the same image as fixed and moving image,
+      // in which case the fixed image and its cast are reused
+      typename TMovingImage::Pointer movingImage;
+      const itk::DataObject* sourceImage = static_cast< const Image& >( this->GetMovingImage( i ) ).GetITKBase();
+      for( unsigned int j = 0; j < this->GetNumberOfFixedImages() && movingImage.IsNull(); ++j )
+      {
+        if( static_cast< const Image& >( this->GetFixedImage( j ) ).GetITKBase() == sourceImage )
+        {
+          movingImage = dynamic_cast< TMovingImage* >( fixedImages[ j ].GetPointer() );
+        }
+      }
+
+      if( movingImage.IsNull() )
+      {
+        movingImage = this->GetITKImage< TMovingImage >( this->GetMovingImage( i ) );
+      }
+
+      elastixFilter->AddMovingImage( CropToPhysicalBoundingBox< TMovingImage >( movingImage, movingLower, movingUpper, this->GetCropToMasksPadding() ) );
     }
 
     elastixFilter->SetInitialTransformParameterFileName( this->GetInitialTransformParameterFileName() );
     elastixFilter->SetFixedPointSetFileName( this->GetFixedPointSetFileName() );
     elastixFilter->SetMovingPointSetFileName( this->GetMovingPointSetFileName() );
 
-    elastixFilter->SetOutputDirectory( this->GetOutputDirectory() );
+    // Elastix writes per-iteration tables to its output directory only. Unless the
+    // user chose an output directory, they are written to a private one, so
+    // processes sharing a working directory do not overwrite each other's tables.
+    const bool isIterationInfoInTemporaryDirectory = this->GetRecordIterationInfo()
+                                                  && ( !this->m_IsOutputDirectorySet || this->GetOutputDirectory().empty() );
+
+    // Elastix only reads point sets from file, so in-memory point sets are handed
+    // over through a private temporary directory that is removed after execution
+    nsstd::auto_ptr< TemporaryDirectory > temporaryDirectory;
+    if( !this->m_FixedPointSet.empty() || !this->m_MovingPointSet.empty() || isIterationInfoInTemporaryDirectory )
+    {
+      temporaryDirectory.reset( new TemporaryDirectory( this ) );
+    }
+
+    if( !this->m_FixedPointSet.empty() )
+    {
+      const std::string fixedPointSetFileName = temporaryDirectory->GetPath() + "/fixedPointSet.txt";
+      WritePointSetFile( fixedPointSetFileName, this->m_FixedPointSet, TFixedImage::ImageDimension );
+      elastixFilter->SetFixedPointSetFileName( fixedPointSetFileName );
+    }
+
+    if( !this->m_MovingPointSet.empty() )
+    {
+      const std::string movingPointSetFileName = temporaryDirectory->GetPath() + "/movingPointSet.txt";
+      WritePointSetFile( movingPointSetFileName, this->m_MovingPointSet, TMovingImage::ImageDimension );
+      elastixFilter->SetMovingPointSetFileName( movingPointSetFileName );
+    }
+
+    const std::string outputDirectory = isIterationInfoInTemporaryDirectory
+                                      ? temporaryDirectory->GetPath()
+                                      : this->GetOutputDirectory();
+    elastixFilter->SetOutputDirectory( outputDirectory );
+
+    // Tables of earlier runs in the user's output directory are not read back
+    if( this->GetRecordIterationInfo() && !isIterationInfoInTemporaryDirectory )
+    {
+      this->RemoveIterationInfo( outputDirectory );
+    }
     elastixFilter->SetLogFileName( this->GetLogFileName() );
     elastixFilter->SetLogToFile( this->GetLogToFile() );
     elastixFilter->SetLogToConsole( this->GetLogToConsole() );
 
-    ParameterMapVectorType parameterMapVector = this->m_ParameterMapVector;
-    for( unsigned int i = 0; i < parameterMapVector.size(); i++ )
+    // The parameter object keeps its own copy, so the internal pixel types are
+    // set on the stored maps only while they are handed over
+    ParameterObjectPointer parameterObject = ParameterObjectType::New();
     {
-      parameterMapVector[ i ][ "FixedInternalImagePixelType" ] 
-        = ParameterValueVectorType( 1, "float" );
-      parameterMapVector[ i ][ "MovingInternalImagePixelType" ]
-        = ParameterValueVectorType( 1, "float" );
+      ParameterMapOverride parameterMapOverride( this->m_ParameterMapVector );
+      parameterMapOverride.Set( "FixedInternalImagePixelType", GetPixelIDValueAsElastixParameter( ImageTypeToPixelIDValue< TFixedImage >::Result ) );
+      parameterMapOverride.Set( "MovingInternalImagePixelType", GetPixelIDValueAsElastixParameter( ImageTypeToPixelIDValue< TMovingImage >::Result ) );
+
+      if( this->HasRandomSeed() )
+      {
+        std::ostringstream randomSeed;
+        randomSeed << this->GetRandomSeed();
+        parameterMapOverride.Set( "RandomSeed", randomSeed.str() );
+      }
+
+      // Pyramid images are computed when their resolution starts and released
+      // when it ends instead of all up front, unless the maps say otherwise
+      if( this->GetLowMemoryMode() )
+      {
+        parameterMapOverride.SetDefault( "ComputePyramidImagesPerResolution", "true" );
+      }
+      parameterObject->SetParameterMap( this->m_ParameterMapVector );
     }
-
-    ParameterObjectPointer parameterObject = ParameterObjectType::New();
-    parameterObject->SetParameterMap( parameterMapVector );
     elastixFilter->SetParameterObject( parameterObject );
-    
+
+    // Connect commands, progress reporting, abort and number of threads
+    this->m_ElastixImageFilter->PreUpdate( elastixFilter.GetPointer() );
+
     elastixFilter->Update();
+    this->m_PeakMemoryUsage = peakMemoryMonitor.GetPeak();
+
+    if( elastixFilter->GetAbortGenerateData() )
+    {
+      sitkExceptionMacro( "Registration was aborted." );
+    }
+
+    // Take over the output buffer instead of copying it
+    typename TFixedImage::Pointer resultImage = elastixFilter->GetOutput();
+    resultImage->DisconnectPipeline();
+    this->m_ResultImage = Image( resultImage );
+    ParameterMapVectorType transformParameterMapVector = elastixFilter->GetTransformParameterObject()->GetParameterMap();
+    this->m_TransformParameterMapVector.swap( transformParameterMapVector );
 
-    this->m_ResultImage = Image( itkDynamicCastInDebugMode< TFixedImage * >( elastixFilter->GetOutput() ) );
-    this->m_ResultImage.MakeUnique();
-    this->m_TransformParameterMapVector = elastixFilter->GetTransformParameterObject()->GetParameterMap();
+    if( isFixedImageCropped )
+    {
+      // The transform parameter maps and the result image both refer to the full
+      // fixed image, so the moving image is resampled onto it as elastix would
+      this->SetFixedImageDomain( this->m_TransformParameterMapVector, this->GetFixedImage( 0 ) );
+      this->m_ResultImage = this->ResampleMovingImageToFixedDomain( this->m_ResultImage.GetPixelID() );
+    }
+
+    this->m_IterationInfo = IterationInfoType();
+    if( this->GetRecordIterationInfo() )
+    {
+      this->ReadIterationInfo( outputDirectory );
+    }
   }
   catch( itk::ExceptionObject &e )
   {
@@ -555,6 +971,7 @@ void
 ElastixImageFilter::ElastixImageFilterImpl
 ::SetFixedPointSetFileName( const std::string fixedPointSetFileName )
 {
+  this->m_FixedPointSet.clear();
   this->m_FixedPointSetFileName = fixedPointSetFileName;
 }
 
@@ -576,6 +993,7 @@ void
 ElastixImageFilter::ElastixImageFilterImpl
 ::SetMovingPointSetFileName( const std::string movingPointSetFileName )
 {
+  this->m_MovingPointSet.clear();
   this->m_MovingPointSetFileName = movingPointSetFileName;
 }
 
@@ -593,11 +1011,56 @@ ElastixImageFilter::ElastixImageFilterImpl
   this->m_MovingPointSetFileName = "";
 }
 
+void
+ElastixImageFilter::ElastixImageFilterImpl
+::SetFixedPointSet( const std::vector< double >& fixedPointSet )
+{
+  this->m_FixedPointSetFileName = "";
+  this->m_FixedPointSet = fixedPointSet;
+}
+
+std::vector< double >
+ElastixImageFilter::ElastixImageFilterImpl
+::GetFixedPointSet( void )
+{
+  return this->m_FixedPointSet;
+}
+
+void
+ElastixImageFilter::ElastixImageFilterImpl
+::RemoveFixedPointSet( void )
+{
+  this->m_FixedPointSet.clear();
+}
+
+void
+ElastixImageFilter::ElastixImageFilterImpl
+::SetMovingPointSet( const std::vector< double >& movingPointSet )
+{
+  this->m_MovingPointSetFileName = "";
+  this->m_MovingPointSet = movingPointSet;
+}
+
+std::vector< double >
+ElastixImageFilter::ElastixImageFilterImpl
+::GetMovingPointSet( void )
+{
+  return this->m_MovingPointSet;
+}
+
+void
+ElastixImageFilter::ElastixImageFilterImpl
+::RemoveMovingPointSet( void )
+{
+  this->m_MovingPointSet.clear();
+}
+
 void
 ElastixImageFilter::ElastixImageFilterImpl
 ::SetOutputDirectory( const std::string outputDirectory )
 {
   this->m_OutputDirectory = outputDirectory;
+  this->m_IsOutputDirectorySet = true;
 }
 
 std::string
@@ -612,6 +1075,7 @@ ElastixImageFilter::ElastixImageFilterImpl
 ::RemoveOutputDirectory( void )
 {
   this->m_OutputDirectory = "";
+  this->m_IsOutputDirectorySet = false;
 }
 
 void
@@ -701,7 +1165,7 @@ ElastixImageFilter::ElastixImageFilterImpl
 
 void
 ElastixImageFilter::ElastixImageFilterImpl
-::SetParameterMap( const ParameterMapType parameterMap )
+::SetParameterMap( const ParameterMapType& parameterMap )
 {
   ParameterMapVectorType parameterMapVector = ParameterMapVectorType( 1, parameterMap );
   this->SetParameterMap( parameterMapVector );
@@ -709,19 +1173,19 @@ ElastixImageFilter::ElastixImageFilterImpl
 
 void
 ElastixImageFilter::ElastixImageFilterImpl
-::SetParameterMap( const ParameterMapVectorType parameterMapVector )
+::SetParameterMap( const ParameterMapVectorType& parameterMapVector )
 {
   this->m_ParameterMapVector = parameterMapVector;
 }
 
 void
 ElastixImageFilter::ElastixImageFilterImpl
-::AddParameterMap( const ParameterMapType parameterMap )
+::AddParameterMap( const ParameterMapType& parameterMap )
 {
   this->m_ParameterMapVector.push_back( parameterMap );
 }
 
-ElastixImageFilter::ElastixImageFilterImpl::ParameterMapVectorType 
+const ElastixImageFilter::ElastixImageFilterImpl::ParameterMapVectorType&
 ElastixImageFilter::ElastixImageFilterImpl
 ::GetParameterMap( void )
 {
@@ -768,7 +1232,7 @@ ElastixImageFilter::ElastixImageFilterImpl
 
 void
 ElastixImageFilter::ElastixImageFilterImpl
-::SetParameter( const ParameterKeyType key, const ParameterValueVectorType value )
+::SetParameter( const ParameterKeyType key, const ParameterValueVectorType& value )
 {
   for( unsigned int i = 0; i < this->m_ParameterMapVector.size(); i++ )
   {
@@ -790,7 +1254,7 @@ ElastixImageFilter::ElastixImageFilterImpl
 
 void
 ElastixImageFilter::ElastixImageFilterImpl
-::SetParameter( const unsigned int index, const ParameterKeyType key, const ParameterValueVectorType value )
+::SetParameter( const unsigned int index, const ParameterKeyType key, const ParameterValueVectorType& value )
 {
   if( index >= this->m_ParameterMapVector.size() )
   {
@@ -812,7 +1276,7 @@ ElastixImageFilter::ElastixImageFilterImpl
 
 void
 ElastixImageFilter::ElastixImageFilterImpl
-::AddParameter( const ParameterKeyType key, const ParameterValueVectorType value )
+::AddParameter( const ParameterKeyType key, const ParameterValueVectorType& value )
 {
   for( unsigned int i = 0; i < this->m_ParameterMapVector.size(); i++ )
   {
@@ -841,7 +1305,7 @@ ElastixImageFilter::ElastixImageFilterImpl
 
 void
 ElastixImageFilter::ElastixImageFilterImpl
-::AddParameter( const unsigned int index, const ParameterKeyType key, const ParameterValueVectorType value )
+::AddParameter( const unsigned int index, const ParameterKeyType key, const ParameterValueVectorType& value )
 {
   if( index >= this->m_ParameterMapVector.size() )
   {
@@ -918,7 +1382,7 @@ ElastixImageFilter::ElastixImageFilterImpl
 
 void
 ElastixImageFilter::ElastixImageFilterImpl
-::WriteParameterFile( ParameterMapType const parameterMap, const std::string parameterFileName )
+::WriteParameterFile( const ParameterMapType& parameterMap, const std::string parameterFileName )
 {
   ParameterObjectPointer parameterObject = ParameterObjectType::New();
   parameterObject->WriteParameterFile( parameterMap, parameterFileName );
@@ -931,7 +1395,7 @@ ElastixImageFilter::ElastixImageFilterImpl
   return ParameterObjectType::GetDefaultParameterMap( transformName, numberOfResolutions, finalGridSpacingInPhysicalUnits );
 }
 
-ElastixImageFilter::ElastixImageFilterImpl::ParameterMapVectorType 
+const ElastixImageFilter::ElastixImageFilterImpl::ParameterMapVectorType&
 ElastixImageFilter::ElastixImageFilterImpl
 ::GetTransformParameterMap( void )
 {
@@ -943,7 +1407,7 @@ ElastixImageFilter::ElastixImageFilterImpl
   return this->m_TransformParameterMapVector;
 }
 
-ElastixImageFilter::ElastixImageFilterImpl::ParameterMapType 
+const ElastixImageFilter::ElastixImageFilterImpl::ParameterMapType&
 ElastixImageFilter::ElastixImageFilterImpl
 ::GetTransformParameterMap( const unsigned int index )
 {
@@ -973,6 +1437,147 @@ ElastixImageFilter::ElastixImageFilterImpl
   return this->m_ResultImage;
 }
 
+Image
+ElastixImageFilter::ElastixImageFilterImpl
+::MoveResultImage( void )
+{
+  Image resultImage = this->GetResultImage();
+  this->m_ResultImage = Image();
+  return resultImage;
+}
+
+void
+ElastixImageFilter::ElastixImageFilterImpl
+::ExecuteAsync( void )
+{
+  this->m_AsyncExecution.Start();
+}
+
+Image
+ElastixImageFilter::ElastixImageFilterImpl
+::Wait( void )
+{
+  this->m_AsyncExecution.Wait();
+  return this->GetResultImage();
+}
+
+bool
+ElastixImageFilter::ElastixImageFilterImpl
+::IsDone( void )
+{
+  return this->m_AsyncExecution.IsDone();
+}
+
+void
+ElastixImageFilter::ElastixImageFilterImpl
+::Cancel( void )
+{
+  this->m_AsyncExecution.Cancel();
+}
+
+void
+ElastixImageFilter::ElastixImageFilterImpl
+::CheckNotExecutingAsync( void )
+{
+  if( this->m_AsyncExecution.IsStarted() )
+  {
+    sitkExceptionMacro( "The filter can not be used while an asynchronous execution is running. Call Wait() first." );
+  }
+}
+
+ElastixImageFilter::ElastixImageFilterImpl::VectorOfImage
+ElastixImageFilter::ElastixImageFilterImpl
+::ExecuteBatch( const Image& fixedImage, const VectorOfImage& movingImages )
+{
+  if( this->IsEmpty( fixedImage ) )
+  {
+    sitkExceptionMacro( "Fixed image is empty." );
+  }
+
+  if( movingImages.size() == 0u )
+  {
+    sitkExceptionMacro( "Cannot register empty vector of moving images." );
+  }
+
+  for( unsigned int i = 0; i < movingImages.size(); ++i )
+  {
+    if( this->IsEmpty( movingImages[ i ] ) )
+    {
+      sitkExceptionMacro( "Moving image at index " << i << " is empty." );
+    }
+  }
+
+  // Elastix keeps global logging and component database state, so registrations
+  // in one process run one at a time, each with the full thread budget. The fixed
+  // image is casted to float and the fixed masks are binarized once, and the same
+  // buffers are passed to every registration whatever the cache settings.
+  const VectorOfImage fixedImages = this->m_FixedImages;
+  const VectorOfImage fixedMasks = this->m_FixedMasks;
+  const VectorOfImage previousMovingImages = this->m_MovingImages;
+
+  Image castFixedImage = fixedImage;
+  bool isFixedImageCast = fixedImage.GetPixelID() == sitkFloat32;
+
+  VectorOfImage binaryFixedMasks;
+  for( unsigned int i = 0; i < this->GetNumberOfFixedMasks(); ++i )
+  {
+    const Image& fixedMask = this->GetFixedMask( i );
+    binaryFixedMasks.push_back( fixedMask.GetPixelID() == sitkUInt8 || !IsIntegerPixelID( fixedMask.GetPixelID() )
+                              ? fixedMask
+                              : NotEqual( fixedMask, 0.0 ) );
+  }
+
+  VectorOfImage resultImages;
+  std::vector< ParameterMapVectorType > batchTransformParameterMapVectors;
+
+  try
+  {
+    this->m_FixedMasks = binaryFixedMasks;
+    for( unsigned int i = 0; i < movingImages.size(); ++i )
+    {
+      // A moving image of the fixed image's pixel type may be registered natively
+      const bool isNativePixelType = this->IsNativePixelTypeEnabled()
+                                  && movingImages[ i ].GetPixelID() == fixedImage.GetPixelID()
+                                  && this->m_DualMemberFactory->HasMemberFunction( fixedImage.GetPixelID(), fixedImage.GetPixelID(), fixedImage.GetDimension() );
+      if( !isNativePixelType && !isFixedImageCast )
+      {
+        castFixedImage = Cast( fixedImage, sitkFloat32 );
+        isFixedImageCast = true;
+      }
+      this->m_FixedImages = VectorOfImage( 1, isNativePixelType ? fixedImage : castFixedImage );
+      this->m_MovingImages = VectorOfImage( 1, movingImages[ i ] );
+      resultImages.push_back( this->Execute() );
+      batchTransformParameterMapVectors.push_back( this->m_TransformParameterMapVector );
+    }
+  }
+  catch( ... )
+  {
+    this->m_FixedImages = fixedImages;
+    this->m_FixedMasks = fixedMasks;
+    this->m_MovingImages = previousMovingImages;
+    throw;
+  }
+
+  this->m_FixedImages = fixedImages;
+  this->m_FixedMasks = fixedMasks;
+  this->m_MovingImages = previousMovingImages;
+  this->m_BatchTransformParameterMapVectors = batchTransformParameterMapVectors;
+
+  return resultImages;
+}
+
+const std::vector< ElastixImageFilter::ElastixImageFilterImpl::ParameterMapVectorType >&
+ElastixImageFilter::ElastixImageFilterImpl
+::GetBatchTransformParameterMap( void )
+{
+  if( this->m_BatchTransformParameterMapVectors.size() == 0 )
+  {
+    sitkExceptionMacro( "Number of batch transform parameter maps: 0. Run registrations with ExecuteBatch()." );
+  }
+
+  return this->m_BatchTransformParameterMapVectors;
+}
+
 ElastixImageFilter::ElastixImageFilterImpl::ParameterMapVectorType
 ElastixImageFilter::ElastixImageFilterImpl
 ::ExecuteInverse( void )
@@ -1006,17 +1611,22 @@ ElastixImageFilter::ElastixImageFilterImpl
     sitkExceptionMacro( "No forward transform parameter map found. Run forward registration before computing the inverse.")
   }
 
-  // Write forward transform parameter file to disk
+  // Elastix only accepts the initial transform of the inverse registration as a
+  // chain of parameter files. The chain is written to a private temporary
+  // directory rather than the output directory, which may be shared between
+  // jobs or read-only.
+  TemporaryDirectory temporaryDirectory( this );
+
   // Head of chain
   std::vector< std::string > forwardTransformParameterFileNames;
-  forwardTransformParameterFileNames.push_back( this->GetOutputDirectory() + "/forwardTransformParameterFile.0.txt" );
+  forwardTransformParameterFileNames.push_back( temporaryDirectory.GetPath() + "/forwardTransformParameterFile.0.txt" );
   ParameterMapVectorType forwardTransformParameterMaps = this->m_TransformParameterMapVector;
   forwardTransformParameterMaps[ 0 ][ "InitialTransformParametersFileName" ] = ParameterValueVectorType( 1, "NoInitialTransform" );
   for( unsigned int i = 1; i < forwardTransformParameterMaps.size(); i++ )
   {
       // Chain transform parameter file
-      forwardTransformParameterFileNames.push_back( this->GetOutputDirectory() + "/forwardTransformParameterFile." + ParameterObjectType::ToString( i ) + ".txt" );
-      forwardTransformParameterMaps[ i ][ "InitialTransformParametersFileName" ] = ParameterValueVectorType( 1, forwardTransformParameterFileNames[ forwardTransformParameterFileNames.size()-1 ] );
+      forwardTransformParameterFileNames.push_back( temporaryDirectory.GetPath() + "/forwardTransformParameterFile." + ParameterObjectType::ToString( i ) + ".txt" );
+      forwardTransformParameterMaps[ i ][ "InitialTransformParametersFileName" ] = ParameterValueVectorType( 1, forwardTransformParameterFileNames[ i - 1 ] );
   }
   ParameterObjectPointer forwardTransformParameterMapObject = ParameterObjectType::New();
   forwardTransformParameterMapObject->SetParameterMap( forwardTransformParameterMaps );
@@ -1035,33 +1645,27 @@ ElastixImageFilter::ElastixImageFilterImpl
     }
   }
 
-  // Setup inverse registration
+  // Setup inverse registration. The tail of the chain holds the complete forward transform.
   ElastixImageFilter selx;
-  selx.SetInitialTransformParameterFileName( forwardTransformParameterFileNames[ 0 ] );
+  selx.SetInitialTransformParameterFileName( forwardTransformParameterFileNames[ forwardTransformParameterFileNames.size() - 1 ] );
   selx.SetParameterMap( inverseParameterMapVector );  
 
-  // Pass options from this ElastixImageFilter
+  // Pass options from this ElastixImageFilter. Nothing is written to the output
+  // directory unless logging to file was requested.
   selx.SetFixedImage( this->GetFixedImage( 0 ) ); 
   selx.SetMovingImage( this->GetFixedImage( 0 ) ); // <-- The fixed image is also used as the moving image. This is not a bug.
-  selx.SetOutputDirectory( this->GetOutputDirectory() );
+  selx.SetOutputDirectory( this->GetLogToFile() ? this->GetOutputDirectory() : "" );
   selx.SetLogFileName( this->GetLogFileName() );
   selx.SetLogToFile( this->GetLogToFile() );
   selx.SetLogToConsole( this->GetLogToConsole() );
+  selx.SetNumberOfThreads( this->m_ElastixImageFilter->GetNumberOfThreads() );
+  if( this->HasRandomSeed() )
+  {
+    selx.SetRandomSeed( this->GetRandomSeed() );
+  }
 
   selx.Execute();
 
-  for( unsigned int i = 0; i < forwardTransformParameterFileNames.size(); i++ )
-  {
-    try
-    {
-      std::remove( forwardTransformParameterFileNames[ i ].c_str() );
-    }
-    catch( ... )
-    {
-      std::cout << "Error removing file " << forwardTransformParameterFileNames[ i ] << ". Continuing ... " << std::endl;
-    }
-  }
-
   // TODO: Change direction/origin/spacing to match moving image
 
   // Unlink the first transform parameter map
@@ -1071,7 +1675,7 @@ ElastixImageFilter::ElastixImageFilterImpl
   return this->m_InverseTransformParameterMapVector;
 }
 
-ElastixImageFilter::ElastixImageFilterImpl::ParameterMapVectorType 
+const ElastixImageFilter::ElastixImageFilterImpl::ParameterMapVectorType&
 ElastixImageFilter::ElastixImageFilterImpl
 ::GetInverseTransformParameterMap( void )
 {
@@ -1083,6 +1687,574 @@ ElastixImageFilter::ElastixImageFilterImpl
   return this->m_InverseTransformParameterMapVector;
 }
 
+void
+ElastixImageFilter::ElastixImageFilterImpl
+::SetMaximumCacheSize( const uint64_t maximumCacheSize )
+{
+  this->m_MaximumCacheSize = maximumCacheSize;
+
+  while( this->m_CacheSize > this->m_MaximumCacheSize )
+  {
+    this->m_CacheSize -= this->m_CastImageCache.back().m_Size;
+    this->m_CastImageCache.pop_back();
+  }
+}
+
+uint64_t
+ElastixImageFilter::ElastixImageFilterImpl
+::GetMaximumCacheSize( void )
+{
+  return this->m_MaximumCacheSize;
+}
+
+uint64_t
+ElastixImageFilter::ElastixImageFilterImpl
+::GetCacheSize( void )
+{
+  return this->m_CacheSize;
+}
+
+void
+ElastixImageFilter::ElastixImageFilterImpl
+::ClearCache( void )
+{
+  this->m_CastImageCache.clear();
+  this->m_CacheSize = 0;
+}
+
+void
+ElastixImageFilter::ElastixImageFilterImpl
+::SetMaximumNumberOfCachedResults( const unsigned int maximumNumberOfCachedResults )
+{
+  this->m_MaximumNumberOfCachedResults = maximumNumberOfCachedResults;
+
+  while( this->m_ResultCache.size() > this->m_MaximumNumberOfCachedResults )
+  {
+    this->m_ResultCache.pop_back();
+  }
+}
+
+unsigned int
+ElastixImageFilter::ElastixImageFilterImpl
+::GetMaximumNumberOfCachedResults( void )
+{
+  return this->m_MaximumNumberOfCachedResults;
+}
+
+unsigned int
+ElastixImageFilter::ElastixImageFilterImpl
+::GetNumberOfCachedResults( void )
+{
+  return static_cast< unsigned int >( this->m_ResultCache.size() );
+}
+
+void
+ElastixImageFilter::ElastixImageFilterImpl
+::ClearResultCache( void )
+{
+  this->m_ResultCache.clear();
+}
+
+void
+ElastixImageFilter::ElastixImageFilterImpl
+::SetResultCacheDirectory( const std::string resultCacheDirectory )
+{
+  this->m_ResultCacheDirectory = resultCacheDirectory;
+}
+
+std::string
+ElastixImageFilter::ElastixImageFilterImpl
+::GetResultCacheDirectory( void )
+{
+  return this->m_ResultCacheDirectory;
+}
+
+void
+ElastixImageFilter::ElastixImageFilterImpl
+::RemoveResultCacheDirectory( void )
+{
+  this->m_ResultCacheDirectory = "";
+}
+
+std::string
+ElastixImageFilter::ElastixImageFilterImpl
+::GetResultCacheKey( void )
+{
+  std::ostringstream key;
+  key.precision( 17 );
+
+  for( unsigned int i = 0; i < this->GetNumberOfFixedImages(); ++i )
+  {
+    AppendImageToKey( key, "FixedImage", this->GetFixedImage( i ) );
+  }
+
+  for( unsigned int i = 0; i < this->GetNumberOfMovingImages(); ++i )
+  {
+    AppendImageToKey( key, "MovingImage", this->GetMovingImage( i ) );
+  }
+
+  for( unsigned int i = 0; i < this->GetNumberOfFixedMasks(); ++i )
+  {
+    AppendImageToKey( key, "FixedMask", this->GetFixedMask( i ) );
+  }
+
+  for( unsigned int i = 0; i < this->GetNumberOfMovingMasks(); ++i )
+  {
+    AppendImageToKey( key, "MovingMask", this->GetMovingMask( i ) );
+  }
+
+  AppendFileToKey( key, "InitialTransformParameterFileName", this->GetInitialTransformParameterFileName() );
+  AppendFileToKey( key, "FixedPointSetFileName", this->GetFixedPointSetFileName() );
+  AppendFileToKey( key, "MovingPointSetFileName", this->GetMovingPointSetFileName() );
+
+  key << "FixedPointSet";
+  for( unsigned int i = 0; i < this->m_FixedPointSet.size(); ++i )
+  {
+    key << " " << this->m_FixedPointSet[ i ];
+  }
+  key << "\nMovingPointSet";
+  for( unsigned int i = 0; i < this->m_MovingPointSet.size(); ++i )
+  {
+    key << " " << this->m_MovingPointSet[ i ];
+  }
+  key << "\nCropToMasks " << this->GetCropToMasks() << " " << this->GetCropToMasksPadding() << "\n";
+  key << "RandomSeed " << this->HasRandomSeed() << " " << this->GetRandomSeed() << "\n";
+  key << "UseNativePixelType " << this->IsNativePixelTypeEnabled() << "\n";
+
+  // Parameter maps are ordered by key, so this is the parameter file format
+  // with keys sorted
+  for( unsigned int i = 0; i < this->m_ParameterMapVector.size(); ++i )
+  {
+    key << "ParameterMap " << i << "\n";
+    for( ParameterMapConstIterator it = this->m_ParameterMapVector[ i ].begin(); it != this->m_ParameterMapVector[ i ].end(); ++it )
+    {
+      key << "(" << it->first;
+      for( unsigned int j = 0; j < it->second.size(); ++j )
+      {
+        key << " \"" << it->second[ j ] << "\"";
+      }
+      key << ")\n";
+    }
+  }
+
+  return MD5Hex( key.str() );
+}
+
+bool
+ElastixImageFilter::ElastixImageFilterImpl
+::FindCachedResult( const std::string& resultCacheKey )
+{
+  for( std::list< ResultCacheEntry >::iterator it = this->m_ResultCache.begin(); it != this->m_ResultCache.end(); ++it )
+  {
+    if( it->m_Key == resultCacheKey )
+    {
+      this->m_ResultCache.splice( this->m_ResultCache.begin(), this->m_ResultCache, it );
+      this->m_ResultImage = it->m_ResultImage;
+      this->m_TransformParameterMapVector = it->m_TransformParameterMapVector;
+      this->m_IterationInfo = IterationInfoType();
+      return true;
+    }
+  }
+
+  if( this->GetResultCacheDirectory().empty() )
+  {
+    return false;
+  }
+
+  const std::string entryDirectory = this->GetResultCacheDirectory() + "/" + resultCacheKey;
+  const std::string resultImageFileName = entryDirectory + "/ResultImage.mha";
+  if( !itksys::SystemTools::FileExists( resultImageFileName.c_str(), true ) )
+  {
+    return false;
+  }
+
+  ParameterMapVectorType transformParameterMapVector;
+  for( unsigned int i = 0; ; ++i )
+  {
+    std::ostringstream transformParameterFileName;
+    transformParameterFileName << entryDirectory << "/TransformParameters." << i << ".txt";
+    if( !itksys::SystemTools::FileExists( transformParameterFileName.str().c_str(), true ) )
+    {
+      break;
+    }
+
+    transformParameterMapVector.push_back( this->ReadParameterFile( transformParameterFileName.str() ) );
+  }
+
+  if( transformParameterMapVector.empty() )
+  {
+    return false;
+  }
+
+  this->m_ResultImage = ReadImage( resultImageFileName );
+  this->m_TransformParameterMapVector.swap( transformParameterMapVector );
+  this->m_IterationInfo = IterationInfoType();
+  this->AddCachedResult( resultCacheKey );
+  return true;
+}
+
+void
+ElastixImageFilter::ElastixImageFilterImpl
+::AddCachedResult( const std::string& resultCacheKey )
+{
+  if( resultCacheKey.empty() )
+  {
+    return;
+  }
+
+  if( this->GetMaximumNumberOfCachedResults() > 0 )
+  {
+    ResultCacheEntry entry;
+    entry.m_Key = resultCacheKey;
+    entry.m_ResultImage = this->m_ResultImage;
+    entry.m_TransformParameterMapVector = this->m_TransformParameterMapVector;
+    this->m_ResultCache.push_front( entry );
+    this->SetMaximumNumberOfCachedResults( this->GetMaximumNumberOfCachedResults() );
+  }
+
+  if( this->GetResultCacheDirectory().empty() )
+  {
+    return;
+  }
+
+  // Entries are written to a private directory first and then renamed, so
+  // other processes sharing the cache directory never read partial entries
+  const std::string entryDirectory = this->GetResultCacheDirectory() + "/" + resultCacheKey;
+  if( itksys::SystemTools::FileExists( entryDirectory.c_str() ) )
+  {
+    return;
+  }
+
+  std::ostringstream partialEntryDirectory;
+  partialEntryDirectory << entryDirectory << ".partial-" << GetCurrentProcessId() << "-" << static_cast< const void* >( this );
+  if( !itksys::SystemTools::MakeDirectory( partialEntryDirectory.str().c_str() ) )
+  {
+    sitkExceptionMacro( "Could not create result cache directory " << partialEntryDirectory.str() << "." );
+  }
+
+  WriteImage( this->m_ResultImage, partialEntryDirectory.str() + "/ResultImage.mha" );
+  for( unsigned int i = 0; i < this->m_TransformParameterMapVector.size(); ++i )
+  {
+    std::ostringstream transformParameterFileName;
+    transformParameterFileName << partialEntryDirectory.str() << "/TransformParameters." << i << ".txt";
+    this->WriteParameterFile( this->m_TransformParameterMapVector[ i ], transformParameterFileName.str() );
+  }
+
+  if( !itksys::SystemTools::RenameFile( partialEntryDirectory.str().c_str(), entryDirectory.c_str() ) )
+  {
+    // Another process stored the same entry first
+    itksys::SystemTools::RemoveADirectory( partialEntryDirectory.str().c_str() );
+  }
+}
+
+void
+ElastixImageFilter::ElastixImageFilterImpl
+::SetCropToMasks( const bool cropToMasks )
+{
+  this->m_CropToMasks = cropToMasks;
+}
+
+bool
+ElastixImageFilter::ElastixImageFilterImpl
+::GetCropToMasks( void )
+{
+  return this->m_CropToMasks;
+}
+
+void
+ElastixImageFilter::ElastixImageFilterImpl
+::CropToMasksOn( void )
+{
+  this->SetCropToMasks( true );
+}
+
+void
+ElastixImageFilter::ElastixImageFilterImpl
+::CropToMasksOff( void )
+{
+  this->SetCropToMasks( false );
+}
+
+void
+ElastixImageFilter::ElastixImageFilterImpl
+::SetCropToMasksPadding( const unsigned int cropToMasksPadding )
+{
+  this->m_CropToMasksPadding = cropToMasksPadding;
+}
+
+unsigned int
+ElastixImageFilter::ElastixImageFilterImpl
+::GetCropToMasksPadding( void )
+{
+  return this->m_CropToMasksPadding;
+}
+
+void
+ElastixImageFilter::ElastixImageFilterImpl
+::SetFixedImageDomain( ParameterMapVectorType& transformParameterMapVector, const Image& fixedImage )
+{
+  // Transform parameters are physical and remain valid. Only the output domain
+  // of the transform parameter maps refers to the cropped fixed image.
+  const unsigned int dimension = fixedImage.GetDimension();
+  const std::vector< unsigned int > size = fixedImage.GetSize();
+  const std::vector< double > origin = fixedImage.GetOrigin();
+  const std::vector< double > spacing = fixedImage.GetSpacing();
+  const std::vector< double > direction = fixedImage.GetDirection();
+
+  ParameterValueVectorType sizeValues, indexValues, originValues, spacingValues, directionValues;
+  for( unsigned int i = 0; i < dimension; ++i )
+  {
+    std::ostringstream sizeValue, originValue, spacingValue;
+    originValue.precision( 17 );
+    spacingValue.precision( 17 );
+    sizeValue << size[ i ];
+    originValue << origin[ i ];
+    spacingValue << spacing[ i ];
+    sizeValues.push_back( sizeValue.str() );
+    indexValues.push_back( "0" );
+    originValues.push_back( originValue.str() );
+    spacingValues.push_back( spacingValue.str() );
+  }
+
+  // Elastix writes the direction cosines column-major
+  for( unsigned int i = 0; i < dimension; ++i )
+  {
+    for( unsigned int j = 0; j < dimension; ++j )
+    {
+      std::ostringstream directionValue;
+      directionValue.precision( 17 );
+      directionValue << direction[ j * dimension + i ];
+      directionValues.push_back( directionValue.str() );
+    }
+  }
+
+  for( unsigned int i = 0; i < transformParameterMapVector.size(); ++i )
+  {
+    transformParameterMapVector[ i ][ "Size" ] = sizeValues;
+    transformParameterMapVector[ i ][ "Index" ] = indexValues;
+    transformParameterMapVector[ i ][ "Origin" ] = originValues;
+    transformParameterMapVector[ i ][ "Spacing" ] = spacingValues;
+    transformParameterMapVector[ i ][ "Direction" ] = directionValues;
+  }
+}
+
+Image
+ElastixImageFilter::ElastixImageFilterImpl
+::ResampleMovingImageToFixedDomain( const PixelIDValueEnum resultPixelID )
+{
+  const ParameterMapType& transformParameterMap = this->m_TransformParameterMapVector.back();
+
+  InterpolatorEnum interpolator = sitkBSpline;
+  ParameterMapConstIterator it = transformParameterMap.find( "ResampleInterpolator" );
+  if( it != transformParameterMap.end() && !it->second.empty() )
+  {
+    if( it->second[ 0 ] == "FinalNearestNeighborInterpolator" )
+    {
+      interpolator = sitkNearestNeighbor;
+    }
+    else if( it->second[ 0 ] == "FinalLinearInterpolator" )
+    {
+      interpolator = sitkLinear;
+    }
+  }
+
+  double defaultPixelValue = 0.0;
+  it = transformParameterMap.find( "DefaultPixelValue" );
+  if( it != transformParameterMap.end() && !it->second.empty() )
+  {
+    defaultPixelValue = std::atof( it->second[ 0 ].c_str() );
+  }
+
+  return Resample( this->GetMovingImage( 0 ), this->GetFixedImage( 0 ),
+                   TransformParameterMapToTransform( this->m_TransformParameterMapVector ),
+                   interpolator, defaultPixelValue, resultPixelID );
+}
+
+void
+ElastixImageFilter::ElastixImageFilterImpl
+::SetRandomSeed( const unsigned int randomSeed )
+{
+  this->m_RandomSeed = randomSeed;
+  this->m_IsRandomSeedSet = true;
+}
+
+unsigned int
+ElastixImageFilter::ElastixImageFilterImpl
+::GetRandomSeed( void )
+{
+  return this->m_RandomSeed;
+}
+
+bool
+ElastixImageFilter::ElastixImageFilterImpl
+::HasRandomSeed( void )
+{
+  return this->m_IsRandomSeedSet;
+}
+
+void
+ElastixImageFilter::ElastixImageFilterImpl
+::RemoveRandomSeed( void )
+{
+  this->m_RandomSeed = 0;
+  this->m_IsRandomSeedSet = false;
+}
+
+void
+ElastixImageFilter::ElastixImageFilterImpl
+::SetLowMemoryMode( const bool lowMemoryMode )
+{
+  this->m_LowMemoryMode = lowMemoryMode;
+}
+
+bool
+ElastixImageFilter::ElastixImageFilterImpl
+::GetLowMemoryMode( void )
+{
+  return this->m_LowMemoryMode;
+}
+
+void
+ElastixImageFilter::ElastixImageFilterImpl
+::LowMemoryModeOn( void )
+{
+  this->SetLowMemoryMode( true );
+}
+
+void
+ElastixImageFilter::ElastixImageFilterImpl
+::LowMemoryModeOff( void )
+{
+  this->SetLowMemoryMode( false );
+}
+
+uint64_t
+ElastixImageFilter::ElastixImageFilterImpl
+::GetPeakMemoryUsage( void )
+{
+  return this->m_PeakMemoryUsage;
+}
+
+void
+ElastixImageFilter::ElastixImageFilterImpl
+::SetUseNativePixelType( const bool useNativePixelType )
+{
+  this->m_UseNativePixelType = useNativePixelType;
+}
+
+bool
+ElastixImageFilter::ElastixImageFilterImpl
+::GetUseNativePixelType( void )
+{
+  return this->m_UseNativePixelType;
+}
+
+void
+ElastixImageFilter::ElastixImageFilterImpl
+::UseNativePixelTypeOn( void )
+{
+  this->SetUseNativePixelType( true );
+}
+
+void
+ElastixImageFilter::ElastixImageFilterImpl
+::UseNativePixelTypeOff( void )
+{
+  this->SetUseNativePixelType( false );
+}
+
+bool
+ElastixImageFilter::ElastixImageFilterImpl
+::IsNativePixelTypeEnabled( void )
+{
+  // Low memory mode avoids the float copy of the inputs where elastix allows
+  return this->GetUseNativePixelType() || this->GetLowMemoryMode();
+}
+
+void
+ElastixImageFilter::ElastixImageFilterImpl
+::SetRecordIterationInfo( const bool recordIterationInfo )
+{
+  this->m_RecordIterationInfo = recordIterationInfo;
+}
+
+bool
+ElastixImageFilter::ElastixImageFilterImpl
+::GetRecordIterationInfo( void )
+{
+  return this->m_RecordIterationInfo;
+}
+
+void
+ElastixImageFilter::ElastixImageFilterImpl
+::RecordIterationInfoOn( void )
+{
+  this->SetRecordIterationInfo( true );
+}
+
+void
+ElastixImageFilter::ElastixImageFilterImpl
+::RecordIterationInfoOff( void )
+{
+  this->SetRecordIterationInfo( false );
+}
+
+ElastixImageFilter::ElastixImageFilterImpl::IterationInfoType
+ElastixImageFilter::ElastixImageFilterImpl
+::GetIterationInfo( void )
+{
+  if( this->m_IterationInfo.empty() )
+  {
+    sitkExceptionMacro( "Iteration info is empty. Turn on RecordIterationInfo and run registration with Execute()." );
+  }
+
+  return this->m_IterationInfo;
+}
+
+void
+ElastixImageFilter::ElastixImageFilterImpl
+::ReadIterationInfo( const std::string& outputDirectory )
+{
+  // Elastix writes one table per parameter map and resolution, numbered from 0.
+  // Tables of earlier runs were removed before the execution, so the tables
+  // found are the ones of the resolutions elastix ran.
+  for( unsigned int i = 0; i < this->m_ParameterMapVector.size(); ++i )
+  {
+    for( unsigned int resolution = 0; ; ++resolution )
+    {
+      const std::string fileName = GetIterationInfoFileName( outputDirectory, i, resolution );
+      if( !itksys::SystemTools::FileExists( fileName.c_str(), true ) )
+      {
+        break;
+      }
+
+      ReadIterationInfoFile( fileName, i, resolution, this->m_IterationInfo );
+    }
+  }
+}
+
+void
+ElastixImageFilter::ElastixImageFilterImpl
+::RemoveIterationInfo( const std::string& outputDirectory )
+{
+  for( unsigned int i = 0; i < this->m_ParameterMapVector.size(); ++i )
+  {
+    for( unsigned int resolution = 0; ; ++resolution )
+    {
+      const std::string fileName = GetIterationInfoFileName( outputDirectory, i, resolution );
+      if( !itksys::SystemTools::FileExists( fileName.c_str(), true ) )
+      {
+        break;
+      }
+
+      if( !itksys::SystemTools::RemoveFile( fileName.c_str() ) )
+      {
+        sitkExceptionMacro( "Could not remove iteration info file " << fileName << " of an earlier run." );
+      }
+    }
+  }
+}
+
 void
 ElastixImageFilter::ElastixImageFilterImpl
 ::PrintParameterMap( void )
@@ -1097,14 +2269,14 @@ ElastixImageFilter::ElastixImageFilterImpl
 
 void
 ElastixImageFilter::ElastixImageFilterImpl
-::PrintParameterMap( const ParameterMapType parameterMap )
+::PrintParameterMap( const ParameterMapType& parameterMap )
 {
   this->PrintParameterMap( ParameterMapVectorType( 1, parameterMap ) );
 }
 
 void
 ElastixImageFilter::ElastixImageFilterImpl
-::PrintParameterMap( const ParameterMapVectorType parameterMapVector )
+::PrintParameterMap( const ParameterMapVectorType& parameterMapVector )
 {
   ParameterObjectPointer parameterObject = ParameterObjectType::New();
   parameterObject->SetParameterMap( parameterMapVector );
@@ -1119,6 +2291,82 @@ ElastixImageFilter::ElastixImageFilterImpl
   return isEmpty;
 }
 
+template< typename TImage >
+typename TImage::Pointer
+ElastixImageFilter::ElastixImageFilterImpl
+::GetITKImage( const Image& image )
+{
+  const PixelIDValueEnum pixelID = static_cast< PixelIDValueEnum >( ImageTypeToPixelIDValue< TImage >::Result );
+
+  if( image.GetPixelID() == pixelID )
+  {
+    // Elastix does not modify its inputs, so the buffer is shared rather than made unique
+    return const_cast< TImage* >( itkDynamicCastInDebugMode< const TImage* >( image.GetITKBase() ) );
+  }
+
+  Image castImage = Cast( image, pixelID );
+  return itkDynamicCastInDebugMode< TImage* >( castImage.GetITKBase() );
+}
+
+template< typename TMaskImage >
+typename TMaskImage::Pointer
+ElastixImageFilter::ElastixImageFilterImpl
+::GetITKMask( const Image& mask )
+{
+  if( mask.GetPixelID() == sitkUInt8 )
+  {
+    // Shared like input images, elastix only reads masks
+    return const_cast< TMaskImage* >( itkDynamicCastInDebugMode< const TMaskImage* >( mask.GetITKBase() ) );
+  }
+
+  // Nonzero voxels are inside the mask
+  Image binaryMask = NotEqual( mask, 0.0 );
+  return itkDynamicCastInDebugMode< TMaskImage* >( binaryMask.GetITKBase() );
+}
+
+template< typename TImage >
+typename TImage::Pointer
+ElastixImageFilter::ElastixImageFilterImpl
+::GetCachedITKImage( const Image& image )
+{
+  const PixelIDValueEnum pixelID = static_cast< PixelIDValueEnum >( ImageTypeToPixelIDValue< TImage >::Result );
+
+  if( image.GetPixelID() == pixelID )
+  {
+    return this->GetITKImage< TImage >( image );
+  }
+
+  const itk::DataObject* sourceImage = image.GetITKBase();
+  for( typename std::list< CastImageCacheEntry >::iterator it = this->m_CastImageCache.begin(); it != this->m_CastImageCache.end(); ++it )
+  {
+    // Only use const access, non-const access would make the images unique
+    const CastImageCacheEntry& entry = *it;
+    if( entry.m_SourceImage.GetITKBase() == sourceImage && entry.m_ModifiedTime == sourceImage->GetMTime() && entry.m_PixelID == pixelID )
+    {
+      this->m_CastImageCache.splice( this->m_CastImageCache.begin(), this->m_CastImageCache, it );
+      return const_cast< TImage* >( itkDynamicCastInDebugMode< const TImage* >( entry.m_CastImage.GetITKBase() ) );
+    }
+  }
+
+  CastImageCacheEntry entry;
+  entry.m_SourceImage = image;
+  entry.m_ModifiedTime = sourceImage->GetMTime();
+  entry.m_PixelID = pixelID;
+  entry.m_CastImage = Cast( image, pixelID );
+  entry.m_Size = entry.m_CastImage.GetNumberOfPixels() * entry.m_CastImage.GetNumberOfComponentsPerPixel() * sizeof( typename TImage::InternalPixelType );
+
+  typename TImage::Pointer castImage = const_cast< TImage* >( itkDynamicCastInDebugMode< const TImage* >( static_cast< const Image& >( entry.m_CastImage ).GetITKBase() ) );
+
+  if( this->m_MaximumCacheSize > 0 && entry.m_Size <= this->m_MaximumCacheSize )
+  {
+    this->m_CastImageCache.push_front( entry );
+    this->m_CacheSize += entry.m_Size;
+    this->SetMaximumCacheSize( this->m_MaximumCacheSize );
+  }
+
+  return castImage;
+}
+
 } // end namespace simple
 } // end namespace itk
 
@@ -5,6 +5,10 @@
 #include "sitkElastixImageFilter.h"
 #include "sitkMemberFunctionFactory.h"
 #include "sitkDualMemberFunctionFactory.h"
+#include "sitkElastixAsyncExecution.h"
+#include "sitkParameterMapOverride.h"
+
+#include <list>
 
 // Elastix
 #include "elxElastixFilter.h"
@@ -16,7 +20,7 @@ namespace itk {
 struct ElastixImageFilter::ElastixImageFilterImpl
 {
 
-  ElastixImageFilterImpl( void );
+  ElastixImageFilterImpl( ElastixImageFilter* elastixImageFilter );
   ~ElastixImageFilterImpl( void );
 
   typedef ElastixImageFilterImpl Self;                                
@@ -32,6 +36,8 @@ struct ElastixImageFilter::ElastixImageFilterImpl
   typedef ElastixImageFilter::ParameterMapIterator         ParameterMapIterator;
   typedef ElastixImageFilter::ParameterMapConstIterator    ParameterMapConstIterator;
 
+  typedef std::map< std::string, std::vector< double > > IterationInfoType;
+
   typedef elastix::ParameterObject                    ParameterObjectType;
   typedef elastix::ParameterObject::Pointer           ParameterObjectPointer;           
 
@@ -81,6 +87,14 @@ struct ElastixImageFilter::ElastixImageFilterImpl
   std::string GetMovingPointSetFileName( void );
   void RemoveMovingPointSetFileName( void );
 
+  void SetFixedPointSet( const std::vector< double >& fixedPointSet );
+  std::vector< double > GetFixedPointSet( void );
+  void RemoveFixedPointSet( void );
+
+  void SetMovingPointSet( const std::vector< double >& movingPointSet );
+  std::vector< double > GetMovingPointSet( void );
+  void RemoveMovingPointSet( void );
+
   void SetOutputDirectory( const std::string outputDirectory );
   std::string GetOutputDirectory( void );
   void RemoveOutputDirectory( void );
@@ -100,21 +114,21 @@ struct ElastixImageFilter::ElastixImageFilterImpl
   void LogToConsoleOff();
 
   void SetParameterMap( const std::string transformName, const unsigned int numberOfResolutions = 4u, const double finalGridSpacingInPhysicalUnits = 10.0 );
-  void SetParameterMap( const std::vector< std::map< std::string, std::vector< std::string > > > parameterMapVector );
-  void SetParameterMap( const std::map< std::string, std::vector< std::string > > parameterMap );
-  void AddParameterMap( const std::map< std::string, std::vector< std::string > > parameterMap );
-  std::vector< std::map< std::string, std::vector< std::string > > > GetParameterMap( void );
+  void SetParameterMap( const std::vector< std::map< std::string, std::vector< std::string > > >& parameterMapVector );
+  void SetParameterMap( const std::map< std::string, std::vector< std::string > >& parameterMap );
+  void AddParameterMap( const std::map< std::string, std::vector< std::string > >& parameterMap );
+  const std::vector< std::map< std::string, std::vector< std::string > > >& GetParameterMap( void );
   std::map< std::string, std::vector< std::string > > GetDefaultParameterMap( const std::string transformName, const unsigned int numberOfResolutions = 4, const double finalGridSpacingInPhysicalUnits = 10.0 );
   unsigned int GetNumberOfParameterMaps( void );
 
   void SetParameter( const std::string key, const std::string value );
-  void SetParameter( const std::string key, const std::vector< std::string > value );
+  void SetParameter( const std::string key, const std::vector< std::string >& value );
   void SetParameter( const unsigned int index, const std::string key, const std::string value );
-  void SetParameter( const unsigned int index, const std::string key, const std::vector< std::string > value );
+  void SetParameter( const unsigned int index, const std::string key, const std::vector< std::string >& value );
   void AddParameter( const std::string key, const std::string value );
   void AddParameter( const unsigned int index, const std::string key, const std::string value );
-  void AddParameter( const std::string key, const std::vector< std::string > value );
-  void AddParameter( const unsigned int index, const std::string key, const std::vector< std::string > value );
+  void AddParameter( const std::string key, const std::vector< std::string >& value );
+  void AddParameter( const unsigned int index, const std::string key, const std::vector< std::string >& value );
   std::vector< std::string > GetParameter( const std::string key );
   std::vector< std::string > GetParameter( const unsigned int index, const std::string key );
   void RemoveParameter( const std::string key );
@@ -125,30 +139,102 @@ struct ElastixImageFilter::ElastixImageFilterImpl
   void RemoveInitialTransformParameterFileName( void );
 
   std::map< std::string, std::vector< std::string > > ReadParameterFile( const std::string filename );
-  void WriteParameterFile( const std::map< std::string, std::vector< std::string > > parameterMap, const std::string filename );
+  void WriteParameterFile( const std::map< std::string, std::vector< std::string > >& parameterMap, const std::string filename );
 
   Image Execute( void );
-  std::vector< std::map< std::string, std::vector< std::string > > > GetTransformParameterMap( void );
-  std::map< std::string, std::vector< std::string > > GetTransformParameterMap( const unsigned int index );
+  const std::vector< std::map< std::string, std::vector< std::string > > >& GetTransformParameterMap( void );
+  const std::map< std::string, std::vector< std::string > >& GetTransformParameterMap( const unsigned int index );
   Image GetResultImage( void );
+  Image MoveResultImage( void );
+
+  void ExecuteAsync( void );
+  Image Wait( void );
+  bool IsDone( void );
+  void Cancel( void );
+
+  // Throws while an asynchronous execution has not been waited for, as
+  // the worker thread uses the filter's inputs and parameter maps
+  void CheckNotExecutingAsync( void );
+
+  VectorOfImage ExecuteBatch( const Image& fixedImage, const VectorOfImage& movingImages );
+  const std::vector< std::vector< std::map< std::string, std::vector< std::string > > > >& GetBatchTransformParameterMap( void );
 
   std::vector< std::map< std::string, std::vector< std::string > > > ExecuteInverse( void );
   std::vector< std::map< std::string, std::vector< std::string > > > ExecuteInverse( std::map< std::string, std::vector< std::string > > inverseParameterMap );
   std::vector< std::map< std::string, std::vector< std::string > > > ExecuteInverse( std::vector< std::map< std::string, std::vector< std::string > > > inverseParameterMapVector );
-  std::vector< std::map< std::string, std::vector< std::string > > > GetInverseTransformParameterMap( void );
+  const std::vector< std::map< std::string, std::vector< std::string > > >& GetInverseTransformParameterMap( void );
+
+  void SetMaximumCacheSize( const uint64_t maximumCacheSize );
+  uint64_t GetMaximumCacheSize( void );
+  uint64_t GetCacheSize( void );
+  void ClearCache( void );
+
+  void SetMaximumNumberOfCachedResults( const unsigned int maximumNumberOfCachedResults );
+  unsigned int GetMaximumNumberOfCachedResults( void );
+  unsigned int GetNumberOfCachedResults( void );
+  void ClearResultCache( void );
+  void SetResultCacheDirectory( const std::string resultCacheDirectory );
+  std::string GetResultCacheDirectory( void );
+  void RemoveResultCacheDirectory( void );
+  std::string GetResultCacheKey( void );
+  bool FindCachedResult( const std::string& resultCacheKey );
+  void AddCachedResult( const std::string& resultCacheKey );
+
+  void SetCropToMasks( const bool cropToMasks );
+  bool GetCropToMasks( void );
+  void CropToMasksOn( void );
+  void CropToMasksOff( void );
+  void SetCropToMasksPadding( const unsigned int cropToMasksPadding );
+  unsigned int GetCropToMasksPadding( void );
+  void SetFixedImageDomain( ParameterMapVectorType& transformParameterMapVector, const Image& fixedImage );
+  Image ResampleMovingImageToFixedDomain( const PixelIDValueEnum resultPixelID );
+
+  void SetRandomSeed( const unsigned int randomSeed );
+  unsigned int GetRandomSeed( void );
+  bool HasRandomSeed( void );
+  void RemoveRandomSeed( void );
+
+  void SetLowMemoryMode( const bool lowMemoryMode );
+  bool GetLowMemoryMode( void );
+  void LowMemoryModeOn( void );
+  void LowMemoryModeOff( void );
+  uint64_t GetPeakMemoryUsage( void );
+
+  void SetUseNativePixelType( const bool useNativePixelType );
+  bool GetUseNativePixelType( void );
+  void UseNativePixelTypeOn( void );
+  void UseNativePixelTypeOff( void );
+  bool IsNativePixelTypeEnabled( void );
+
+  void SetRecordIterationInfo( const bool recordIterationInfo );
+  bool GetRecordIterationInfo( void );
+  void RecordIterationInfoOn( void );
+  void RecordIterationInfoOff( void );
+  IterationInfoType GetIterationInfo( void );
+  void ReadIterationInfo( const std::string& outputDirectory );
+  void RemoveIterationInfo( const std::string& outputDirectory );
 
   void PrintParameterMap( void );
-  void PrintParameterMap( const ParameterMapType parameterMapVector );
-  void PrintParameterMap( const ParameterMapVectorType parameterMapVector );
+  void PrintParameterMap( const ParameterMapType& parameterMapVector );
+  void PrintParameterMap( const ParameterMapVectorType& parameterMapVector );
 
   bool IsEmpty( const Image& image );
 
+  template< typename TImage > typename TImage::Pointer GetITKImage( const Image& image );
+  template< typename TImage > typename TImage::Pointer GetCachedITKImage( const Image& image );
+  template< typename TMaskImage > typename TMaskImage::Pointer GetITKMask( const Image& mask );
+
   // Definitions for SimpleITK member factory
   typedef Image ( Self::*MemberFunctionType )( void );
   template< class TFixedImage, class TMovingImage > Image DualExecuteInternal( void );
   friend struct detail::DualExecuteInternalAddressor< MemberFunctionType >;
   nsstd::auto_ptr< detail::DualMemberFunctionFactory< MemberFunctionType > > m_DualMemberFactory;
 
+  // The process object that owns this implementation. Commands, progress,
+  // abort and number of threads are forwarded to elastix through it.
+  ElastixImageFilter*     m_ElastixImageFilter;
+  AsyncExecution< Self >  m_AsyncExecution;
+
   VectorOfImage           m_FixedImages;
   VectorOfImage           m_MovingImages;
   VectorOfImage           m_FixedMasks;
@@ -158,17 +244,63 @@ struct ElastixImageFilter::ElastixImageFilterImpl
   std::string             m_InitialTransformParameterMapFileName;
   std::string             m_FixedPointSetFileName;
   std::string             m_MovingPointSetFileName;
+  std::vector< double >   m_FixedPointSet;
+  std::vector< double >   m_MovingPointSet;
 
   ParameterMapVectorType  m_ParameterMapVector;
   ParameterMapVectorType  m_TransformParameterMapVector;
   ParameterMapVectorType  m_InverseTransformParameterMapVector;
+  std::vector< ParameterMapVectorType > m_BatchTransformParameterMapVectors;
 
   std::string             m_OutputDirectory;
+  bool                    m_IsOutputDirectorySet;
   std::string             m_LogFileName;
 
   bool                    m_LogToFile;
   bool                    m_LogToConsole;
 
+  // Casted fixed images, most recently used first. The source image is held
+  // so that its buffer can not be reused by another image with the same key.
+  struct CastImageCacheEntry
+  {
+    Image             m_SourceImage;
+    unsigned long     m_ModifiedTime;
+    PixelIDValueEnum  m_PixelID;
+    Image             m_CastImage;
+    uint64_t          m_Size;
+  };
+
+  std::list< CastImageCacheEntry > m_CastImageCache;
+  uint64_t                m_CacheSize;
+  uint64_t                m_MaximumCacheSize;
+
+  // Registration results, most recently used first, keyed on an MD5 digest of
+  // the input hashes and the parameter maps
+  struct ResultCacheEntry
+  {
+    std::string             m_Key;
+    Image                   m_ResultImage;
+    ParameterMapVectorType  m_TransformParameterMapVector;
+  };
+
+  std::list< ResultCacheEntry > m_ResultCache;
+  unsigned int            m_MaximumNumberOfCachedResults;
+  std::string             m_ResultCacheDirectory;
+
+  bool                    m_CropToMasks;
+  unsigned int            m_CropToMasksPadding;
+
+  unsigned int            m_RandomSeed;
+  bool                    m_IsRandomSeedSet;
+
+  bool                    m_LowMemoryMode;
+  uint64_t                m_PeakMemoryUsage;
+
+  bool                    m_UseNativePixelType;
+
+  bool                    m_RecordIterationInfo;
+  IterationInfoType       m_IterationInfo;
+
 };
 
 } // end namespace simple
@@ -0,0 +1,112 @@
+#ifndef __sitkelastixmemoryusage_h_
+#define __sitkelastixmemoryusage_h_
+
+#include "sitkMacro.h"
+
+#ifdef _WIN32
+#include "itkWindows.h"
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#ifdef __linux__
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#endif
+
+namespace itk {
+  namespace simple {
+
+// Returns the peak resident set size of this process in bytes, or 0 if the
+// platform does not report it. This is a process wide high-water mark, so it
+// includes memory that was in use before an execution started.
+inline uint64_t GetPeakResidentMemory( void )
+{
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS processMemoryCounters;
+  if( !GetProcessMemoryInfo( GetCurrentProcess(), &processMemoryCounters, sizeof( processMemoryCounters ) ) )
+  {
+    return 0;
+  }
+
+  return static_cast< uint64_t >( processMemoryCounters.PeakWorkingSetSize );
+#else
+  struct rusage resourceUsage;
+  if( getrusage( RUSAGE_SELF, &resourceUsage ) != 0 )
+  {
+    return 0;
+  }
+
+#ifdef __APPLE__
+  // Bytes on macOS, kilobytes elsewhere
+  return static_cast< uint64_t >( resourceUsage.ru_maxrss );
+#else
+  return static_cast< uint64_t >( resourceUsage.ru_maxrss ) * 1024;
+#endif
+#endif
+}
+
+#ifdef __linux__
+// Reads a "<field>:  <value> kB" line of /proc/self/status in bytes, or 0
+inline uint64_t ReadProcessStatusMemory( const std::string& field )
+{
+  std::ifstream status( "/proc/self/status" );
+  std::string line;
+  while( std::getline( status, line ) )
+  {
+    if( line.compare( 0, field.size() + 1, field + ":" ) == 0 )
+    {
+      return static_cast< uint64_t >( std::strtoul( line.c_str() + field.size() + 1, 0, 10 ) ) * 1024;
+    }
+  }
+
+  return 0;
+}
+#endif
+
+// Measures the peak resident set size of the process while it is in scope.
+// On Linux the high-water mark of the process is reset when it is created, so
+// GetPeak() is exact, but the process wide peak no longer covers the time
+// before. Elsewhere the high-water mark can not be reset. GetPeak() is then
+// the peak during the scope if it raised the high-water mark, and otherwise
+// the earlier, higher peak of the process.
+class PeakMemoryMonitor
+{
+public:
+
+  PeakMemoryMonitor( void ) : m_IsReset( false )
+  {
+#ifdef __linux__
+    // Writing 5 resets the peak resident set size (Linux 4.0 and later)
+    std::ofstream clearRefs( "/proc/self/clear_refs" );
+    clearRefs << "5";
+    clearRefs.close();
+    this->m_IsReset = !clearRefs.fail() && ReadProcessStatusMemory( "VmHWM" ) > 0;
+#endif
+  }
+
+  uint64_t GetPeak( void ) const
+  {
+#ifdef __linux__
+    if( this->m_IsReset )
+    {
+      return ReadProcessStatusMemory( "VmHWM" );
+    }
+#endif
+    return GetPeakResidentMemory();
+  }
+
+private:
+
+  PeakMemoryMonitor( const PeakMemoryMonitor& );
+  void operator=( const PeakMemoryMonitor& );
+
+  bool m_IsReset;
+};
+
+} // end namespace simple
+} // end namespace itk
+
+#endif // __sitkelastixmemoryusage_h_
@@ -0,0 +1,273 @@
+#ifndef __sitkelastixtemporaryfiles_h_
+#define __sitkelastixtemporaryfiles_h_
+
+#include "sitkMacro.h"
+
+#include <itksys/SystemTools.hxx>
+
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <direct.h>
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+
+namespace itk {
+  namespace simple {
+
+inline int GetCurrentProcessId( void )
+{
+#ifdef _WIN32
+  return _getpid();
+#else
+  return getpid();
+#endif
+}
+
+// Elastix and transformix only exchange some data through files. This directory
+// is private to one filter in one process, so concurrent jobs never share
+// intermediate files and the user's output directory is left untouched. It is
+// always newly created, so a file or link planted at its path by another user
+// is never written to. The directory and its content are removed when it goes
+// out of scope.
+class TemporaryDirectory
+{
+public:
+
+  TemporaryDirectory( const void* owner )
+  {
+    std::string temporaryDirectory;
+
+#ifdef _WIN32
+    if( !itksys::SystemTools::GetEnv( "TMP", temporaryDirectory )
+      && !itksys::SystemTools::GetEnv( "TEMP", temporaryDirectory ) )
+    {
+      sitkExceptionMacro( "Can not find temporary directory. Tried TMP and TEMP environment variables." );
+    }
+
+    // _mkdir fails if the path exists, so a new name is tried until one is free
+    const unsigned int maximumNumberOfAttempts = 100;
+    for( unsigned int attempt = 0; attempt < maximumNumberOfAttempts; ++attempt )
+    {
+      std::ostringstream path;
+      path << temporaryDirectory << "/SimpleElastix-" << GetCurrentProcessId() << "-" << owner << "-" << attempt;
+      if( _mkdir( path.str().c_str() ) == 0 )
+      {
+        this->m_Path = path.str();
+        return;
+      }
+
+      if( errno != EEXIST )
+      {
+        sitkExceptionMacro( "Could not create temporary directory " << path.str() << "." );
+      }
+    }
+
+    sitkExceptionMacro( "Could not create a temporary directory in " << temporaryDirectory << "." );
+#else
+    (void)owner;
+
+    if( !itksys::SystemTools::GetEnv( "TMPDIR", temporaryDirectory ) )
+    {
+      temporaryDirectory = "/tmp";
+    }
+
+    // mkdtemp creates a directory with a unique name that only the user can access
+    const std::string pathTemplate = temporaryDirectory + "/SimpleElastix-XXXXXX";
+    std::vector< char > path( pathTemplate.begin(), pathTemplate.end() );
+    path.push_back( '\0' );
+    if( mkdtemp( &path[ 0 ] ) == NULL )
+    {
+      sitkExceptionMacro( "Could not create temporary directory " << pathTemplate << "." );
+    }
+    this->m_Path = &path[ 0 ];
+#endif
+  }
+
+  ~TemporaryDirectory( void )
+  {
+    itksys::SystemTools::RemoveADirectory( this->m_Path.c_str() );
+  }
+
+  const std::string& GetPath( void ) const
+  {
+    return this->m_Path;
+  }
+
+private:
+
+  TemporaryDirectory( const TemporaryDirectory& );
+  void operator=( const TemporaryDirectory& );
+
+  std::string m_Path;
+};
+
+// Writes a flat buffer of physical point coordinates (x0 y0 [z0] x1 y1 [z1] ...)
+// in the elastix point set file format
+inline void WritePointSetFile( const std::string& fileName, const std::vector< double >& pointSet, const unsigned int dimension )
+{
+  if( dimension == 0 || pointSet.size() % dimension != 0 )
+  {
+    sitkExceptionMacro( "Number of point set coordinates (" << pointSet.size() << ") is not a multiple of the image dimension (" << dimension << ")." );
+  }
+
+  std::ofstream pointSetFile( fileName.c_str(), std::ofstream::out );
+  if( !pointSetFile.is_open() )
+  {
+    sitkExceptionMacro( "Could not open point set file " << fileName << " for writing." );
+  }
+
+  pointSetFile.precision( 17 );
+  pointSetFile << "point\n" << pointSet.size() / dimension << "\n";
+  for( std::size_t i = 0; i < pointSet.size(); i += dimension )
+  {
+    for( unsigned int j = 0; j < dimension; ++j )
+    {
+      pointSetFile << pointSet[ i + j ] << ( j + 1 < dimension ? ' ' : '\n' );
+    }
+  }
+}
+
+// Reads the "OutputPoint = [ ... ]" entries of a transformix outputpoints.txt
+// file into a flat buffer of physical point coordinates
+inline std::vector< double > ReadOutputPointSetFile( const std::string& fileName )
+{
+  std::ifstream pointSetFile( fileName.c_str() );
+  if( !pointSetFile.is_open() )
+  {
+    sitkExceptionMacro( "Could not open output point set file " << fileName << "." );
+  }
+
+  const std::string outputPointKey = "OutputPoint = [";
+  std::vector< double > pointSet;
+  std::string line;
+  while( std::getline( pointSetFile, line ) )
+  {
+    const std::string::size_type begin = line.find( outputPointKey );
+    if( begin == std::string::npos )
+    {
+      continue;
+    }
+
+    const std::string::size_type end = line.find( ']', begin );
+    std::istringstream coordinates( line.substr( begin + outputPointKey.size(), end - begin - outputPointKey.size() ) );
+    double coordinate;
+    while( coordinates >> coordinate )
+    {
+      pointSet.push_back( coordinate );
+    }
+  }
+
+  return pointSet;
+}
+
+// The name of the table elastix writes for a parameter map and resolution
+inline std::string GetIterationInfoFileName( const std::string& outputDirectory,
+                                             const unsigned int parameterMapIndex,
+                                             const unsigned int resolution )
+{
+  std::ostringstream fileName;
+  fileName << outputDirectory << "/IterationInfo." << parameterMapIndex << ".R" << resolution << ".txt";
+  return fileName.str();
+}
+
+// Appends the rows of an elastix IterationInfo.<index>.R<resolution>.txt table to
+// a table of columns. Column names are stripped of their "1:", "3a:" ... prefix.
+// Columns that are missing from a file, or values that are not numbers, are NaN,
+// so all columns of the table keep the same length.
+inline void ReadIterationInfoFile( const std::string& fileName,
+                                   const unsigned int parameterMapIndex,
+                                   const unsigned int resolution,
+                                   std::map< std::string, std::vector< double > >& iterationInfo )
+{
+  std::ifstream iterationInfoFile( fileName.c_str() );
+  if( !iterationInfoFile.is_open() )
+  {
+    sitkExceptionMacro( "Could not open iteration info file " << fileName << "." );
+  }
+
+  const double nan = std::numeric_limits< double >::quiet_NaN();
+  std::size_t numberOfRows = iterationInfo.empty() ? 0 : iterationInfo.begin()->second.size();
+
+  std::string line;
+  if( !std::getline( iterationInfoFile, line ) )
+  {
+    return;
+  }
+
+  std::vector< std::string > columnNames;
+  std::istringstream header( line );
+  std::string columnName;
+  while( std::getline( header, columnName, '\t' ) )
+  {
+    const std::string::size_type colon = columnName.find( ':' );
+    if( colon != std::string::npos && colon > 0 && columnName[ 0 ] >= '0' && columnName[ 0 ] <= '9' )
+    {
+      columnName = columnName.substr( colon + 1 );
+    }
+
+    if( iterationInfo.find( columnName ) == iterationInfo.end() )
+    {
+      iterationInfo[ columnName ] = std::vector< double >( numberOfRows, nan );
+    }
+
+    columnNames.push_back( columnName );
+  }
+
+  if( iterationInfo.find( "ParameterMap" ) == iterationInfo.end() )
+  {
+    iterationInfo[ "ParameterMap" ] = std::vector< double >( numberOfRows, nan );
+    iterationInfo[ "Resolution" ] = std::vector< double >( numberOfRows, nan );
+  }
+
+  while( std::getline( iterationInfoFile, line ) )
+  {
+    if( line.find_first_not_of( " \t\r" ) == std::string::npos )
+    {
+      continue;
+    }
+
+    std::istringstream row( line );
+    std::string value;
+    for( unsigned int i = 0; i < columnNames.size(); ++i )
+    {
+      double number = nan;
+      if( std::getline( row, value, '\t' ) )
+      {
+        char* end = 0;
+        const double parsed = std::strtod( value.c_str(), &end );
+        if( end != value.c_str() )
+        {
+          number = parsed;
+        }
+      }
+
+      iterationInfo[ columnNames[ i ] ].push_back( number );
+    }
+
+    iterationInfo[ "ParameterMap" ].push_back( parameterMapIndex );
+    iterationInfo[ "Resolution" ].push_back( resolution );
+    ++numberOfRows;
+
+    std::map< std::string, std::vector< double > >::iterator column;
+    for( column = iterationInfo.begin(); column != iterationInfo.end(); ++column )
+    {
+      column->second.resize( numberOfRows, nan );
+    }
+  }
+}
+
+} // end namespace simple
+} // end namespace itk
+
+#endif // __sitkelastixtemporaryfiles_h_
@@ -0,0 +1,71 @@
+#ifndef __sitknumberofthreadsguard_h_
+#define __sitknumberofthreadsguard_h_
+
+#include "sitkElastixAsyncExecution.h"
+
+#include "itkMultiThreader.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace itk {
+  namespace simple {
+
+// Elastix and transformix create their internal filters, metric threaders and
+// OpenMP regions with the global default number of threads, and offer no
+// per-instance setting. This guard sets that default to the number of threads
+// of one execution and restores the previous value when the execution goes
+// out of scope. The OpenMP setting only applies to parallel regions started
+// from the calling thread.
+//
+// The ITK default is process wide, so the guard is only constructed while the
+// elastix execution lock is held: executions then restore their values in
+// order. ITK filters created by other threads during an execution still get
+// its number of threads.
+class NumberOfThreadsGuard
+{
+public:
+
+  NumberOfThreadsGuard( const ElastixExecutionLock&, const unsigned int numberOfThreads )
+  {
+    this->m_PreviousNumberOfThreads = MultiThreader::GetGlobalDefaultNumberOfThreads();
+    if( numberOfThreads > 0 )
+    {
+      MultiThreader::SetGlobalDefaultNumberOfThreads( numberOfThreads );
+    }
+
+#ifdef _OPENMP
+    this->m_PreviousNumberOfOpenMPThreads = omp_get_max_threads();
+    if( numberOfThreads > 0 )
+    {
+      omp_set_num_threads( static_cast< int >( numberOfThreads ) );
+    }
+#endif
+  }
+
+  ~NumberOfThreadsGuard( void )
+  {
+    MultiThreader::SetGlobalDefaultNumberOfThreads( this->m_PreviousNumberOfThreads );
+
+#ifdef _OPENMP
+    omp_set_num_threads( this->m_PreviousNumberOfOpenMPThreads );
+#endif
+  }
+
+private:
+
+  NumberOfThreadsGuard( const NumberOfThreadsGuard& );
+  void operator=( const NumberOfThreadsGuard& );
+
+  ThreadIdType m_PreviousNumberOfThreads;
+
+#ifdef _OPENMP
+  int m_PreviousNumberOfOpenMPThreads;
+#endif
+};
+
+} // end namespace simple
+} // end namespace itk
+
+#endif // __sitknumberofthreadsguard_h_
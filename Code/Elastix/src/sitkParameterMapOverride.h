@@ -0,0 +1,110 @@
+#ifndef __sitkparametermapoverride_h_
+#define __sitkparametermapoverride_h_
+
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace itk {
+  namespace simple {
+
+// Temporarily sets parameters on a vector of parameter maps that is owned by
+// the filter. The original values are restored when the override goes out of
+// scope, so the maps can be handed to elastix without first copying them.
+class ParameterMapOverride
+{
+public:
+
+  typedef std::vector< std::string >                   ParameterValueVectorType;
+  typedef std::map< std::string, ParameterValueVectorType > ParameterMapType;
+  typedef std::vector< ParameterMapType >              ParameterMapVectorType;
+
+  ParameterMapOverride( ParameterMapVectorType& parameterMapVector ) : m_ParameterMapVector( parameterMapVector ) {}
+
+  ~ParameterMapOverride( void )
+  {
+    // Restore in reverse order so that a key set twice gets its first value back
+    for( std::list< SavedParameter >::reverse_iterator it = this->m_SavedParameters.rbegin(); it != this->m_SavedParameters.rend(); ++it )
+    {
+      ParameterMapType& parameterMap = this->m_ParameterMapVector[ it->m_Index ];
+      if( it->m_HasValue )
+      {
+        parameterMap[ it->m_Key ].swap( it->m_Value );
+      }
+      else
+      {
+        parameterMap.erase( it->m_Key );
+      }
+    }
+  }
+
+  // Sets key to value in every parameter map
+  void Set( const std::string& key, const std::string& value )
+  {
+    this->Set( key, ParameterValueVectorType( 1, value ) );
+  }
+
+  void Set( const std::string& key, const ParameterValueVectorType& value )
+  {
+    for( unsigned int i = 0; i < this->m_ParameterMapVector.size(); ++i )
+    {
+      ParameterMapType& parameterMap = this->m_ParameterMapVector[ i ];
+      ParameterMapType::iterator it = parameterMap.find( key );
+
+      this->m_SavedParameters.push_back( SavedParameter() );
+      SavedParameter& saved = this->m_SavedParameters.back();
+      saved.m_Index = i;
+      saved.m_Key = key;
+      saved.m_HasValue = it != parameterMap.end();
+      if( saved.m_HasValue )
+      {
+        saved.m_Value.swap( it->second );
+        it->second = value;
+      }
+      else
+      {
+        parameterMap[ key ] = value;
+      }
+    }
+  }
+
+  // Sets key to value in parameter maps that do not define key
+  void SetDefault( const std::string& key, const std::string& value )
+  {
+    for( unsigned int i = 0; i < this->m_ParameterMapVector.size(); ++i )
+    {
+      ParameterMapType& parameterMap = this->m_ParameterMapVector[ i ];
+      if( parameterMap.find( key ) == parameterMap.end() )
+      {
+        this->m_SavedParameters.push_back( SavedParameter() );
+        SavedParameter& saved = this->m_SavedParameters.back();
+        saved.m_Index = i;
+        saved.m_Key = key;
+        saved.m_HasValue = false;
+        parameterMap[ key ] = ParameterValueVectorType( 1, value );
+      }
+    }
+  }
+
+private:
+
+  struct SavedParameter
+  {
+    unsigned int             m_Index;
+    std::string              m_Key;
+    bool                     m_HasValue;
+    ParameterValueVectorType m_Value;
+  };
+
+  ParameterMapOverride( const ParameterMapOverride& );
+  void operator=( const ParameterMapOverride& );
+
+  ParameterMapVectorType&   m_ParameterMapVector;
+  std::list< SavedParameter > m_SavedParameters;
+};
+
+} // end namespace simple
+} // end namespace itk
+
+#endif // __sitkparametermapoverride_h_
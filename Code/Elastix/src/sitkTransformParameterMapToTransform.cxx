@@ -0,0 +1,242 @@
+#ifndef __sitktransformparametermaptotransform_cxx_
+#define __sitktransformparametermaptotransform_cxx_
+
+#include "sitkElastixImageFilter.h"
+#include "sitkAffineTransform.h"
+#include "sitkBSplineTransform.h"
+#include "sitkEuler2DTransform.h"
+#include "sitkEuler3DTransform.h"
+#include "sitkSimilarity2DTransform.h"
+#include "sitkSimilarity3DTransform.h"
+#include "sitkTranslationTransform.h"
+
+#include <cstdlib>
+#include <list>
+#include <sstream>
+
+namespace itk {
+  namespace simple {
+
+namespace {
+
+typedef std::map< std::string, std::vector< std::string > > ParameterMapType;
+typedef std::vector< ParameterMapType >                     ParameterMapVectorType;
+
+const std::vector< std::string >& GetParameterValues( const ParameterMapType& parameterMap, const std::string& key )
+{
+  ParameterMapType::const_iterator it = parameterMap.find( key );
+  if( it == parameterMap.end() || it->second.empty() )
+  {
+    sitkExceptionMacro( "Transform parameter map does not contain \"" << key << "\"." );
+  }
+
+  return it->second;
+}
+
+std::vector< double > GetParameterAsDouble( const ParameterMapType& parameterMap, const std::string& key )
+{
+  const std::vector< std::string >& values = GetParameterValues( parameterMap, key );
+  std::vector< double > result( values.size() );
+  for( unsigned int i = 0; i < values.size(); ++i )
+  {
+    std::istringstream value( values[ i ] );
+    if( !( value >> result[ i ] ) )
+    {
+      sitkExceptionMacro( "Could not convert value \"" << values[ i ] << "\" of \"" << key << "\" to a number." );
+    }
+  }
+
+  return result;
+}
+
+std::string GetParameterAsString( const ParameterMapType& parameterMap, const std::string& key, const std::string& defaultValue )
+{
+  ParameterMapType::const_iterator it = parameterMap.find( key );
+  if( it == parameterMap.end() || it->second.empty() )
+  {
+    return defaultValue;
+  }
+
+  return it->second[ 0 ];
+}
+
+void CheckNumberOfParameters( const std::vector< double >& parameters, const unsigned int numberOfParameters, const std::string& transformName )
+{
+  if( parameters.size() != numberOfParameters )
+  {
+    sitkExceptionMacro( transformName << " expects " << numberOfParameters << " transform parameters, got " << parameters.size() << "." );
+  }
+}
+
+// Converts a single transform parameter map, not following its initial transform
+Transform ConvertTransformParameterMap( const ParameterMapType& parameterMap )
+{
+  const std::string transformName = GetParameterValues( parameterMap, "Transform" )[ 0 ];
+  const unsigned int dimension = static_cast< unsigned int >( GetParameterAsDouble( parameterMap, "FixedImageDimension" )[ 0 ] );
+  const std::vector< double > parameters = GetParameterAsDouble( parameterMap, "TransformParameters" );
+
+  if( dimension != 2 && dimension != 3 )
+  {
+    sitkExceptionMacro( "Only 2D and 3D transforms can be converted (transform parameter map is of dimension " << dimension << ")." );
+  }
+
+  if( transformName == "TranslationTransform" )
+  {
+    CheckNumberOfParameters( parameters, dimension, transformName );
+    TranslationTransform transform( dimension, parameters );
+    return transform;
+  }
+
+  if( transformName == "EulerTransform" )
+  {
+    const std::vector< double > center = GetParameterAsDouble( parameterMap, "CenterOfRotationPoint" );
+    if( dimension == 2 )
+    {
+      CheckNumberOfParameters( parameters, 3, transformName );
+      Euler2DTransform transform;
+      transform.SetCenter( center );
+      transform.SetParameters( parameters );
+      return transform;
+    }
+
+    CheckNumberOfParameters( parameters, 6, transformName );
+    Euler3DTransform transform;
+    transform.SetCenter( center );
+    transform.SetComputeZYX( GetParameterAsString( parameterMap, "ComputeZYX", "false" ) == "true" );
+    transform.SetParameters( parameters );
+    return transform;
+  }
+
+  if( transformName == "SimilarityTransform" )
+  {
+    const std::vector< double > center = GetParameterAsDouble( parameterMap, "CenterOfRotationPoint" );
+    if( dimension == 2 )
+    {
+      CheckNumberOfParameters( parameters, 4, transformName );
+      Similarity2DTransform transform;
+      transform.SetCenter( center );
+      transform.SetParameters( parameters );
+      return transform;
+    }
+
+    CheckNumberOfParameters( parameters, 7, transformName );
+    Similarity3DTransform transform;
+    transform.SetCenter( center );
+    transform.SetParameters( parameters );
+    return transform;
+  }
+
+  if( transformName == "AffineTransform" )
+  {
+    CheckNumberOfParameters( parameters, dimension * ( dimension + 1 ), transformName );
+    AffineTransform transform( dimension );
+    transform.SetCenter( GetParameterAsDouble( parameterMap, "CenterOfRotationPoint" ) );
+    transform.SetParameters( parameters );
+    return transform;
+  }
+
+  if( transformName == "BSplineTransform" || transformName == "RecursiveBSplineTransform" )
+  {
+    const std::vector< double > gridSize = GetParameterAsDouble( parameterMap, "GridSize" );
+    const std::vector< double > gridOrigin = GetParameterAsDouble( parameterMap, "GridOrigin" );
+    const std::vector< double > gridSpacing = GetParameterAsDouble( parameterMap, "GridSpacing" );
+    const std::vector< double > gridDirection = GetParameterAsDouble( parameterMap, "GridDirection" );
+    const unsigned int splineOrder = static_cast< unsigned int >( std::atof( GetParameterAsString( parameterMap, "BSplineTransformSplineOrder", "3" ).c_str() ) );
+
+    if( gridSize.size() != dimension || gridOrigin.size() != dimension || gridSpacing.size() != dimension || gridDirection.size() != dimension * dimension )
+    {
+      sitkExceptionMacro( "B-spline grid parameters do not match the transform dimension " << dimension << "." );
+    }
+
+    // The fixed parameters of the ITK B-spline transform describe the same
+    // coefficient grid: size, origin, spacing and row-major direction.
+    // Elastix writes the grid direction column-major.
+    std::vector< double > fixedParameters;
+    fixedParameters.insert( fixedParameters.end(), gridSize.begin(), gridSize.end() );
+    fixedParameters.insert( fixedParameters.end(), gridOrigin.begin(), gridOrigin.end() );
+    fixedParameters.insert( fixedParameters.end(), gridSpacing.begin(), gridSpacing.end() );
+    for( unsigned int i = 0; i < dimension; ++i )
+    {
+      for( unsigned int j = 0; j < dimension; ++j )
+      {
+        fixedParameters.push_back( gridDirection[ i + j * dimension ] );
+      }
+    }
+
+    unsigned int numberOfParameters = dimension;
+    for( unsigned int i = 0; i < dimension; ++i )
+    {
+      numberOfParameters *= static_cast< unsigned int >( gridSize[ i ] );
+    }
+    CheckNumberOfParameters( parameters, numberOfParameters, transformName );
+
+    BSplineTransform transform( dimension, splineOrder );
+    transform.SetFixedParameters( fixedParameters );
+    transform.SetParameters( parameters );
+    return transform;
+  }
+
+  sitkExceptionMacro( "Cannot convert elastix transform \"" << transformName << "\". Supported transforms are "
+                   << "TranslationTransform, EulerTransform, SimilarityTransform, AffineTransform, BSplineTransform and RecursiveBSplineTransform." );
+}
+
+} // end anonymous namespace
+
+Transform
+TransformParameterMapToTransform( const std::map< std::string, std::vector< std::string > >& transformParameterMap )
+{
+  return TransformParameterMapToTransform( ParameterMapVectorType( 1, transformParameterMap ) );
+}
+
+Transform
+TransformParameterMapToTransform( const std::vector< std::map< std::string, std::vector< std::string > > >& transformParameterMapVector )
+{
+  if( transformParameterMapVector.size() == 0 )
+  {
+    sitkExceptionMacro( "Cannot convert empty vector of transform parameter maps." );
+  }
+
+  // Each map in the vector is initialized by the previous one. The first map
+  // may in turn be initialized by a chain of transform parameter files. The
+  // chain refers to the maps, only maps read from file are stored here.
+  std::list< ParameterMapType > initialTransformParameterMaps;
+  std::vector< const ParameterMapType* > chain;
+  std::string initialTransformParameterFileName = GetParameterAsString( transformParameterMapVector[ 0 ], "InitialTransformParametersFileName", "NoInitialTransform" );
+  while( initialTransformParameterFileName != "NoInitialTransform" )
+  {
+    initialTransformParameterMaps.push_front( ReadParameterFile( initialTransformParameterFileName ) );
+    initialTransformParameterFileName = GetParameterAsString( initialTransformParameterMaps.front(), "InitialTransformParametersFileName", "NoInitialTransform" );
+  }
+
+  for( std::list< ParameterMapType >::const_iterator it = initialTransformParameterMaps.begin(); it != initialTransformParameterMaps.end(); ++it )
+  {
+    chain.push_back( &*it );
+  }
+
+  for( unsigned int i = 0; i < transformParameterMapVector.size(); ++i )
+  {
+    chain.push_back( &transformParameterMapVector[ i ] );
+  }
+
+  // Elastix composes the current transform with its initial transform,
+  // T( x ) = T_n( ... T_1( T_0( x ) ) ). An ITK composite transform applies
+  // the last added transform first.
+  Transform transform = ConvertTransformParameterMap( *chain.back() );
+  for( int i = static_cast< int >( chain.size() ) - 2; i >= 0; --i )
+  {
+    if( GetParameterAsString( *chain[ i + 1 ], "HowToCombineTransforms", "Compose" ) != "Compose" )
+    {
+      sitkExceptionMacro( "Only transforms combined with \"Compose\" can be converted (transform parameter map at index "
+                       << i + 1 << " uses \"" << GetParameterAsString( *chain[ i + 1 ], "HowToCombineTransforms", "" ) << "\")." );
+    }
+
+    transform.AddTransform( ConvertTransformParameterMap( *chain[ i ] ) );
+  }
+
+  return transform;
+}
+
+} // end namespace simple
+} // end namespace itk
+
+#endif // __sitktransformparametermaptotransform_cxx_
@@ -8,7 +8,7 @@ namespace itk {
   namespace simple {
 
 TransformixImageFilter
-::TransformixImageFilter( void ) : m_Pimple( new TransformixImageFilterImpl )
+::TransformixImageFilter( void ) : m_Pimple( new TransformixImageFilterImpl( this ) )
 {
 }
 
@@ -19,17 +19,32 @@ TransformixImageFilter
   m_Pimple = NULL;
 }
 
-const std::string 
+std::string 
 TransformixImageFilter
-::GetName( void )
+::GetName( void ) const
 { 
   return this->m_Pimple->GetName();
 }
 
+void
+TransformixImageFilter
+::SetNumberOfThreads( unsigned int n )
+{
+  Superclass::SetNumberOfThreads( n );
+}
+
+unsigned int
+TransformixImageFilter
+::GetNumberOfThreads( void ) const
+{
+  return Superclass::GetNumberOfThreads();
+}
+
 TransformixImageFilter::Self&
 TransformixImageFilter
 ::SetMovingImage( const Image& movingImage )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetMovingImage( movingImage );
   return *this;
 }
@@ -38,6 +53,7 @@ Image&
 TransformixImageFilter
 ::GetMovingImage( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetMovingImage();
 }
 
@@ -45,6 +61,7 @@ TransformixImageFilter::Self&
 TransformixImageFilter
 ::RemoveMovingImage( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->RemoveMovingImage();
   return *this;
 }
@@ -53,6 +70,7 @@ TransformixImageFilter::Self&
 TransformixImageFilter
 ::SetFixedPointSetFileName( const std::string movingPointSetFileName )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetFixedPointSetFileName( movingPointSetFileName );
   return *this;
 }
@@ -61,6 +79,7 @@ std::string
 TransformixImageFilter
 ::GetFixedPointSetFileName( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetFixedPointSetFileName();
 }
 
@@ -68,14 +87,42 @@ TransformixImageFilter::Self&
 TransformixImageFilter
 ::RemoveFixedPointSetFileName( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->RemoveFixedPointSetFileName();
   return *this;
 }
 
+TransformixImageFilter::Self& 
+TransformixImageFilter
+::SetFixedPointSet( const std::vector< double >& fixedPointSet )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  this->m_Pimple->SetFixedPointSet( fixedPointSet );
+  return *this;
+}
+
+std::vector< double >
+TransformixImageFilter
+::GetFixedPointSet( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  return this->m_Pimple->GetFixedPointSet();
+}
+
+TransformixImageFilter::Self&
+TransformixImageFilter
+::RemoveFixedPointSet( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  this->m_Pimple->RemoveFixedPointSet();
+  return *this;
+}
+
 TransformixImageFilter::Self&
 TransformixImageFilter
 ::SetComputeSpatialJacobian( const bool computeSpatialJacobian )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetComputeSpatialJacobian( computeSpatialJacobian );
   return *this;
 }
@@ -84,6 +131,7 @@ bool
 TransformixImageFilter
 ::GetComputeSpatialJacobian( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetComputeSpatialJacobian();
 }
 
@@ -91,6 +139,7 @@ TransformixImageFilter::Self&
 TransformixImageFilter
 ::ComputeSpatialJacobianOn( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetComputeSpatialJacobian( true );
   return *this;
 }
@@ -99,6 +148,7 @@ TransformixImageFilter::Self&
 TransformixImageFilter
 ::ComputeSpatialJacobianOff( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetComputeSpatialJacobian( false );
   return *this;
 }
@@ -107,6 +157,7 @@ TransformixImageFilter::Self&
 TransformixImageFilter
 ::SetComputeDeterminantOfSpatialJacobian( const bool computeDeterminantOfSpatialJacobian )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetComputeDeterminantOfSpatialJacobian( computeDeterminantOfSpatialJacobian );
   return *this;
 }
@@ -115,6 +166,7 @@ bool
 TransformixImageFilter
 ::GetComputeDeterminantOfSpatialJacobian( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetComputeDeterminantOfSpatialJacobian();
 }
 
@@ -122,6 +174,7 @@ TransformixImageFilter::Self&
 TransformixImageFilter
 ::ComputeDeterminantOfSpatialJacobianOn( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetComputeDeterminantOfSpatialJacobian( true );
   return *this;
 }
@@ -130,6 +183,7 @@ TransformixImageFilter::Self&
 TransformixImageFilter
 ::ComputeDeterminantOfSpatialJacobianOff( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetComputeDeterminantOfSpatialJacobian( false );
   return *this;
 }
@@ -138,6 +192,7 @@ TransformixImageFilter::Self&
 TransformixImageFilter
 ::SetComputeDeformationField( const bool computeDeformationField )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetComputeDeformationField( computeDeformationField );
   return *this;
 }
@@ -146,6 +201,7 @@ bool
 TransformixImageFilter
 ::GetComputeDeformationField( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetComputeDeformationField();
 }
 
@@ -153,6 +209,7 @@ TransformixImageFilter::Self&
 TransformixImageFilter
 ::ComputeDeformationFieldOn( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetComputeDeformationField( true );
   return *this;
 }
@@ -161,6 +218,7 @@ TransformixImageFilter::Self&
 TransformixImageFilter
 ::ComputeDeformationFieldOff( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetComputeDeformationField( false );
   return *this;
 }
@@ -169,6 +227,7 @@ TransformixImageFilter::Self&
 TransformixImageFilter
 ::SetOutputDirectory( const std::string outputDirectory )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetOutputDirectory( outputDirectory );
   return *this;
 }
@@ -177,6 +236,7 @@ std::string
 TransformixImageFilter
 ::GetOutputDirectory( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetOutputDirectory();
 }
 
@@ -184,14 +244,59 @@ TransformixImageFilter::Self&
 TransformixImageFilter
 ::RemoveOutputDirectory( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->RemoveOutputDirectory();
   return *this;
 }
 
+TransformixImageFilter::Self&
+TransformixImageFilter
+::SetResultImageFileName( const std::string resultImageFileName )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  this->m_Pimple->SetResultImageFileName( resultImageFileName );
+  return *this;
+}
+
+std::string
+TransformixImageFilter
+::GetResultImageFileName( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  return this->m_Pimple->GetResultImageFileName();
+}
+
+TransformixImageFilter::Self&
+TransformixImageFilter
+::RemoveResultImageFileName( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  this->m_Pimple->RemoveResultImageFileName();
+  return *this;
+}
+
+TransformixImageFilter::Self&
+TransformixImageFilter
+::SetNumberOfStreamDivisions( const unsigned int numberOfStreamDivisions )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  this->m_Pimple->SetNumberOfStreamDivisions( numberOfStreamDivisions );
+  return *this;
+}
+
+unsigned int
+TransformixImageFilter
+::GetNumberOfStreamDivisions( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  return this->m_Pimple->GetNumberOfStreamDivisions();
+}
+
 TransformixImageFilter::Self& 
 TransformixImageFilter
 ::SetLogFileName( std::string logFileName )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetLogFileName( logFileName );
   return *this;
 }
@@ -200,6 +305,7 @@ std::string
 TransformixImageFilter
 ::GetLogFileName( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetLogFileName();
 }
 
@@ -207,6 +313,7 @@ TransformixImageFilter::Self&
 TransformixImageFilter
 ::RemoveLogFileName( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->RemoveLogFileName();
   return *this;
 }
@@ -215,6 +322,7 @@ TransformixImageFilter::Self&
 TransformixImageFilter
 ::SetLogToFile( bool logToFile )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetLogToFile( logToFile );
   return *this;
 }
@@ -223,6 +331,7 @@ bool
 TransformixImageFilter
 ::GetLogToFile( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetLogToFile();
 }
 
@@ -230,6 +339,7 @@ TransformixImageFilter::Self&
 TransformixImageFilter
 ::LogToFileOn()
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetLogToFile( true );
   return *this;
 }
@@ -238,6 +348,7 @@ TransformixImageFilter::Self&
 TransformixImageFilter
 ::LogToFileOff()
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetLogToFile( false );
   return *this;
 }
@@ -246,6 +357,7 @@ TransformixImageFilter::Self&
 TransformixImageFilter
 ::SetLogToConsole( bool logToConsole )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetLogToConsole( logToConsole );
   return *this;
 }
@@ -254,6 +366,7 @@ bool
 TransformixImageFilter
 ::GetLogToConsole( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetLogToConsole();
 }
 
@@ -261,6 +374,7 @@ TransformixImageFilter::Self&
 TransformixImageFilter
 ::LogToConsoleOn()
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetLogToConsole( true );
   return *this;
 }
@@ -269,30 +383,34 @@ TransformixImageFilter::Self&
 TransformixImageFilter
 ::LogToConsoleOff()
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetLogToConsole( false );
   return *this;
 }
 
 TransformixImageFilter::Self&
 TransformixImageFilter
-::SetTransformParameterMap( const ParameterMapVectorType transformParameterMapVector )
+::SetTransformParameterMap( const ParameterMapVectorType& transformParameterMapVector )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetTransformParameterMap( transformParameterMapVector );
   return *this;
 }
 
 TransformixImageFilter::Self&
 TransformixImageFilter
-::SetTransformParameterMap( const ParameterMapType transformParameterMap )
+::SetTransformParameterMap( const ParameterMapType& transformParameterMap )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetTransformParameterMap( transformParameterMap );
   return *this;
 }
 
 TransformixImageFilter::Self&
 TransformixImageFilter
-::AddTransformParameterMap( const ParameterMapType transformParameterMap )
+::AddTransformParameterMap( const ParameterMapType& transformParameterMap )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->AddTransformParameterMap( transformParameterMap );
   return *this;
 }
@@ -301,6 +419,7 @@ TransformixImageFilter::ParameterMapVectorType
 TransformixImageFilter
 ::GetTransformParameterMap( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetTransformParameterMap();
 }
 
@@ -308,6 +427,7 @@ unsigned int
 TransformixImageFilter
 ::GetNumberOfTransformParameterMaps( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetNumberOfTransformParameterMaps();
 }
 
@@ -315,14 +435,16 @@ TransformixImageFilter::Self&
 TransformixImageFilter
 ::SetTransformParameter( const ParameterKeyType key, const ParameterValueType value )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetTransformParameter( key, value );
   return *this;
 }
 
 TransformixImageFilter::Self&
 TransformixImageFilter
-::SetTransformParameter( const ParameterKeyType key, const ParameterValueVectorType value )
+::SetTransformParameter( const ParameterKeyType key, const ParameterValueVectorType& value )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetTransformParameter( key, value );
   return *this;
 }
@@ -331,14 +453,16 @@ TransformixImageFilter::Self&
 TransformixImageFilter
 ::SetTransformParameter( const unsigned int index, const ParameterKeyType key, const ParameterValueType value )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetTransformParameter( index, key, value );
   return *this;
 }
 
 TransformixImageFilter::Self&
 TransformixImageFilter
-::SetTransformParameter( const unsigned int index, const ParameterKeyType key, const ParameterValueVectorType value )
+::SetTransformParameter( const unsigned int index, const ParameterKeyType key, const ParameterValueVectorType& value )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->SetTransformParameter( index, key, value );
   return *this;
 }
@@ -347,6 +471,7 @@ TransformixImageFilter::Self&
 TransformixImageFilter
 ::AddTransformParameter( const ParameterKeyType key, const ParameterValueType value )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->AddTransformParameter( key, value );
   return *this;
 }
@@ -355,6 +480,7 @@ TransformixImageFilter::Self&
 TransformixImageFilter
 ::AddTransformParameter( const unsigned int index, const ParameterKeyType key, const ParameterValueType value )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->AddTransformParameter( index, key, value );
   return *this;
 }
@@ -363,6 +489,7 @@ TransformixImageFilter::ParameterValueVectorType
 TransformixImageFilter
 ::GetTransformParameter( const ParameterKeyType key )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetTransformParameter( key );
 }
 
@@ -370,6 +497,7 @@ TransformixImageFilter::ParameterValueVectorType
 TransformixImageFilter
 ::GetTransformParameter( const unsigned int index, const ParameterKeyType key )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetTransformParameter( index, key );
 }
 
@@ -377,6 +505,7 @@ TransformixImageFilter::Self&
 TransformixImageFilter
 ::RemoveTransformParameter( const ParameterKeyType key )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->RemoveTransformParameter( key );
   return *this;
 }
@@ -385,6 +514,7 @@ TransformixImageFilter::Self&
 TransformixImageFilter
 ::RemoveTransformParameter( const unsigned int index, const ParameterKeyType key )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->RemoveTransformParameter( index, key );
   return *this;
 }
@@ -398,7 +528,7 @@ TransformixImageFilter
 
 TransformixImageFilter::Self&
 TransformixImageFilter
-::WriteParameterFile( const ParameterMapType parameterMap, const std::string parameterFileName )
+::WriteParameterFile( const ParameterMapType& parameterMap, const std::string parameterFileName )
 {
   this->m_Pimple->WriteParameterFile( parameterMap, parameterFileName );
   return *this;
@@ -408,13 +538,14 @@ TransformixImageFilter::Self&
 TransformixImageFilter
 ::PrintParameterMap( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   this->m_Pimple->PrintParameterMap();
   return *this;
 }
 
 TransformixImageFilter::Self& 
 TransformixImageFilter
-::PrintParameterMap( const ParameterMapType parameterMap )
+::PrintParameterMap( const ParameterMapType& parameterMap )
 {
   this->m_Pimple->PrintParameterMap( parameterMap );
   return *this;
@@ -422,7 +553,7 @@ TransformixImageFilter
 
 TransformixImageFilter::Self& 
 TransformixImageFilter
-::PrintParameterMap( const ParameterMapVectorType parameterMapVector )
+::PrintParameterMap( const ParameterMapVectorType& parameterMapVector )
 {
   this->m_Pimple->PrintParameterMap( parameterMapVector );
   return *this;
@@ -432,22 +563,102 @@ Image
 TransformixImageFilter
 ::Execute( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->Execute();
 }
 
+TransformixImageFilter::VectorOfImage
+TransformixImageFilter
+::Execute( const VectorOfImage& movingImages )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  return this->m_Pimple->Execute( movingImages );
+}
+
+TransformixImageFilter::Self&
+TransformixImageFilter
+::ExecuteAsync( void )
+{
+  this->m_Pimple->ExecuteAsync();
+  return *this;
+}
+
+Image
+TransformixImageFilter
+::Wait( void )
+{
+  return this->m_Pimple->Wait();
+}
+
+bool
+TransformixImageFilter
+::IsDone( void )
+{
+  return this->m_Pimple->IsDone();
+}
+
+TransformixImageFilter::Self&
+TransformixImageFilter
+::Cancel( void )
+{
+  this->m_Pimple->Cancel();
+  return *this;
+}
+
 Image
 TransformixImageFilter
 ::GetResultImage( void )
 {
+  this->m_Pimple->CheckNotExecutingAsync();
   return this->m_Pimple->GetResultImage();
 }
 
+Image
+TransformixImageFilter
+::MoveResultImage( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  return this->m_Pimple->MoveResultImage();
+}
+
+std::vector< double >
+TransformixImageFilter
+::GetResultPointSet( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  return this->m_Pimple->GetResultPointSet();
+}
+
+Image
+TransformixImageFilter
+::GetDeformationField( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  return this->m_Pimple->GetDeformationField();
+}
+
+Image
+TransformixImageFilter
+::GetSpatialJacobian( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  return this->m_Pimple->GetSpatialJacobian();
+}
+
+Image
+TransformixImageFilter
+::GetDeterminantOfSpatialJacobian( void )
+{
+  this->m_Pimple->CheckNotExecutingAsync();
+  return this->m_Pimple->GetDeterminantOfSpatialJacobian();
+}
+
 /**
  * Procedural interface 
  */
 
 Image
-Transformix( const Image& movingImage, const TransformixImageFilter::ParameterMapType parameterMap, const bool logToConsole, const std::string outputDirectory )
+Transformix( const Image& movingImage, const TransformixImageFilter::ParameterMapType& parameterMap, const bool logToConsole, const std::string outputDirectory )
 {
   TransformixImageFilter::ParameterMapVectorType parameterMapVector;
   parameterMapVector.push_back( parameterMap );
@@ -455,7 +666,7 @@ Transformix( const Image& movingImage, const TransformixImageFilter::ParameterMa
 }
 
 Image
-Transformix( const Image& movingImage, const TransformixImageFilter::ParameterMapVectorType parameterMapVector, const bool logToConsole, const std::string outputDirectory )
+Transformix( const Image& movingImage, const TransformixImageFilter::ParameterMapVectorType& parameterMapVector, const bool logToConsole, const std::string outputDirectory )
 {
   TransformixImageFilter stfx;
   stfx.SetMovingImage( movingImage );
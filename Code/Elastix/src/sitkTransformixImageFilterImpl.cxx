@@ -4,12 +4,50 @@
 #include "sitkTransformixImageFilter.h"
 #include "sitkTransformixImageFilterImpl.h"
 #include "sitkCastImageFilter.h"
+#include "sitkNumberOfThreadsGuard.h"
+#include "sitkElastixTemporaryFiles.h"
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkVectorImage.h"
+
+#include <itksys/SystemTools.hxx>
+
+#include <cstdlib>
+#include <sstream>
 
 namespace itk {
   namespace simple {
 
+namespace {
+
+// Reads the output geometry of transformix from a transform parameter map
+std::vector< double > GetOutputGeometry( const std::map< std::string, std::vector< std::string > >& transformParameterMap,
+                                         const std::string& key, const unsigned int numberOfValues )
+{
+  std::map< std::string, std::vector< std::string > >::const_iterator it = transformParameterMap.find( key );
+  if( it == transformParameterMap.end() || it->second.size() != numberOfValues )
+  {
+    sitkExceptionMacro( "Transform parameter map must contain " << numberOfValues << " values for \"" << key << "\"." );
+  }
+
+  std::vector< double > values( numberOfValues );
+  for( unsigned int i = 0; i < numberOfValues; ++i )
+  {
+    std::istringstream value( it->second[ i ] );
+    if( !( value >> values[ i ] ) )
+    {
+      sitkExceptionMacro( "Could not convert value \"" << it->second[ i ] << "\" of \"" << key << "\" to a number." );
+    }
+  }
+
+  return values;
+}
+
+} // end anonymous namespace
+
 TransformixImageFilter::TransformixImageFilterImpl
-::TransformixImageFilterImpl( void )
+::TransformixImageFilterImpl( TransformixImageFilter* transformixImageFilter ) : m_TransformixImageFilter( transformixImageFilter ), m_AsyncExecution( this )
 {
   // Register this class with SimpleITK
   this->m_MemberFactory.reset( new detail::MemberFunctionFactory< MemberFunctionType >( this ) );
@@ -22,16 +60,24 @@ TransformixImageFilter::TransformixImageFilterImpl
 
   this->m_MovingImage = Image();
   this->m_ResultImage = Image();
+  this->m_DeformationField = Image();
+  this->m_SpatialJacobian = Image();
+  this->m_DeterminantOfSpatialJacobian = Image();
 
   this->m_TransformParameterMapVector = ParameterMapVectorType();
 
   this->m_ComputeSpatialJacobian = false;
   this->m_ComputeDeterminantOfSpatialJacobian = false;
   this->m_ComputeDeformationField = false;
-  this->m_MovingPointSetFileName = "";
+  this->m_FixedPointSetFileName = "";
+  this->m_FixedPointSet = std::vector< double >();
+  this->m_ResultPointSet = std::vector< double >();
 
   this->m_OutputDirectory = "";
   this->m_LogFileName = "";
+
+  this->m_ResultImageFileName = "";
+  this->m_NumberOfStreamDivisions = 16;
   
   this->m_LogToFile = "";
   this->m_LogToConsole = "";
@@ -40,6 +86,15 @@ TransformixImageFilter::TransformixImageFilterImpl
 TransformixImageFilter::TransformixImageFilterImpl
 ::~TransformixImageFilterImpl( void )
 {
+  // The worker thread uses this object, so it must finish first
+  this->m_AsyncExecution.Cancel();
+  try
+  {
+    this->m_AsyncExecution.Wait();
+  }
+  catch( ... )
+  {
+  }
 }
 
 Image
@@ -47,7 +102,17 @@ TransformixImageFilter::TransformixImageFilterImpl
 ::Execute( void )
 {
   const PixelIDValueEnum MovingImagePixelEnum = this->m_MovingImage.GetPixelID();
-  const unsigned int MovingImageDimension = this->m_MovingImage.GetDimension();
+  unsigned int MovingImageDimension = this->m_MovingImage.GetDimension();
+
+  // Without a moving image only points are transformed. The dimension is then
+  // taken from the transform.
+  if( this->IsEmpty( this->m_MovingImage ) 
+    && this->m_TransformParameterMapVector.size() > 0
+    && this->m_TransformParameterMapVector[ 0 ].count( "FixedImageDimension" )
+    && this->m_TransformParameterMapVector[ 0 ][ "FixedImageDimension" ].size() > 0 )
+  {
+    MovingImageDimension = std::atoi( this->m_TransformParameterMapVector[ 0 ][ "FixedImageDimension" ][ 0 ].c_str() );
+  }
 
   if( this->m_MemberFactory->HasMemberFunction( sitkFloat32, MovingImageDimension ) )
   {
@@ -60,6 +125,91 @@ TransformixImageFilter::TransformixImageFilterImpl
                       << "Contact developers at https://github.com/kaspermarstal/SimpleElastix/issues." );
 }
 
+TransformixImageFilter::TransformixImageFilterImpl::VectorOfImage
+TransformixImageFilter::TransformixImageFilterImpl
+::Execute( const VectorOfImage& movingImages )
+{
+  if( movingImages.size() == 0u )
+  {
+    sitkExceptionMacro( "Cannot transform empty vector of moving images." );
+  }
+
+  if( !this->GetResultImageFileName().empty() )
+  {
+    sitkExceptionMacro( "Cannot write the result images of a vector of moving images to a single result image file." );
+  }
+
+  for( unsigned int i = 0; i < movingImages.size(); ++i )
+  {
+    if( this->IsEmpty( movingImages[ i ] ) )
+    {
+      sitkExceptionMacro( "Moving image at index " << i << " is empty." );
+    }
+  }
+
+  // Settings that are changed while transforming the batch and restored afterwards
+  const Image movingImage = this->m_MovingImage;
+  const std::string fixedPointSetFileName = this->m_FixedPointSetFileName;
+  const std::vector< double > fixedPointSet = this->m_FixedPointSet;
+  const bool computeSpatialJacobian = this->m_ComputeSpatialJacobian;
+  const bool computeDeterminantOfSpatialJacobian = this->m_ComputeDeterminantOfSpatialJacobian;
+  const bool computeDeformationField = this->m_ComputeDeformationField;
+
+  VectorOfImage resultImages;
+  std::vector< double > resultPointSet;
+  Image deformationField;
+  Image spatialJacobian;
+  Image determinantOfSpatialJacobian;
+
+  try
+  {
+    for( unsigned int i = 0; i < movingImages.size(); ++i )
+    {
+      this->m_MovingImage = movingImages[ i ];
+      resultImages.push_back( this->Execute() );
+
+      // Outputs that only depend on the transform are kept from the first image
+      if( i == 0 )
+      {
+        resultPointSet = this->m_ResultPointSet;
+        deformationField = this->m_DeformationField;
+        spatialJacobian = this->m_SpatialJacobian;
+        determinantOfSpatialJacobian = this->m_DeterminantOfSpatialJacobian;
+
+        this->m_FixedPointSetFileName = "";
+        this->m_FixedPointSet.clear();
+        this->m_ComputeSpatialJacobian = false;
+        this->m_ComputeDeterminantOfSpatialJacobian = false;
+        this->m_ComputeDeformationField = false;
+      }
+    }
+  }
+  catch( ... )
+  {
+    this->m_MovingImage = movingImage;
+    this->m_FixedPointSetFileName = fixedPointSetFileName;
+    this->m_FixedPointSet = fixedPointSet;
+    this->m_ComputeSpatialJacobian = computeSpatialJacobian;
+    this->m_ComputeDeterminantOfSpatialJacobian = computeDeterminantOfSpatialJacobian;
+    this->m_ComputeDeformationField = computeDeformationField;
+    throw;
+  }
+
+  this->m_MovingImage = movingImage;
+  this->m_FixedPointSetFileName = fixedPointSetFileName;
+  this->m_FixedPointSet = fixedPointSet;
+  this->m_ComputeSpatialJacobian = computeSpatialJacobian;
+  this->m_ComputeDeterminantOfSpatialJacobian = computeDeterminantOfSpatialJacobian;
+  this->m_ComputeDeformationField = computeDeformationField;
+
+  this->m_ResultPointSet = resultPointSet;
+  this->m_DeformationField = deformationField;
+  this->m_SpatialJacobian = spatialJacobian;
+  this->m_DeterminantOfSpatialJacobian = determinantOfSpatialJacobian;
+
+  return resultImages;
+}
+
 template< typename TMovingImage >
 Image
 TransformixImageFilter::TransformixImageFilterImpl
@@ -70,10 +220,26 @@ TransformixImageFilter::TransformixImageFilterImpl
 
   try
   {
+    ElastixExecutionLock elastixExecutionLock( GetElastixExecutionMutex() );
+
+    if( this->m_AsyncExecution.IsCancelled() )
+    {
+      sitkExceptionMacro( "Transformation was cancelled." );
+    }
+
+    // Scope the thread budget of this filter to this execution
+    NumberOfThreadsGuard numberOfThreadsGuard( elastixExecutionLock, this->m_TransformixImageFilter->GetNumberOfThreads() );
+
+    if( !this->GetResultImageFileName().empty() )
+    {
+      this->WriteResultImageInternal< TMovingImage >();
+      return this->m_ResultImage;
+    }
+
     TransforimxFilterPointer transformixFilter = TransformixFilterType::New();
 
     if( !this->IsEmpty( this->m_MovingImage ) ) {
-      transformixFilter->SetMovingImage( itkDynamicCastInDebugMode< TMovingImage* >( Cast( this->GetMovingImage(), static_cast< PixelIDValueEnum >( GetPixelIDValueFromElastixString( "float" ) ) ).GetITKBase() ) );
+      transformixFilter->SetMovingImage( this->GetITKImage< TMovingImage >( this->GetMovingImage() ) );
     }
 
     transformixFilter->SetFixedPointSetFileName( this->GetFixedPointSetFileName() );
@@ -81,27 +247,109 @@ TransformixImageFilter::TransformixImageFilterImpl
     transformixFilter->SetComputeDeterminantOfSpatialJacobian( this->GetComputeDeterminantOfSpatialJacobian() );
     transformixFilter->SetComputeDeformationField( this->GetComputeDeformationField() );
 
-    transformixFilter->SetOutputDirectory( this->GetOutputDirectory() );
+    // Transformix only reads point sets from file and only writes transformed
+    // points, deformation fields and spatial Jacobians to the output directory.
+    // In-memory point sets are handed over through a private temporary directory.
+    // When no output directory is set, results are read back from there as well.
+    // The temporary directory is removed after execution.
+    const bool hasFileResults = !this->m_FixedPointSet.empty() || !this->GetFixedPointSetFileName().empty()
+      || this->GetComputeDeformationField() || this->GetComputeSpatialJacobian() || this->GetComputeDeterminantOfSpatialJacobian();
+
+    nsstd::auto_ptr< TemporaryDirectory > temporaryDirectory;
+    if( !this->m_FixedPointSet.empty() || ( hasFileResults && this->GetOutputDirectory().empty() ) )
+    {
+      temporaryDirectory.reset( new TemporaryDirectory( this ) );
+    }
+
+    const std::string resultDirectory = this->GetOutputDirectory().empty() && temporaryDirectory.get() ? temporaryDirectory->GetPath() : this->GetOutputDirectory();
+    transformixFilter->SetOutputDirectory( resultDirectory );
+
+    if( !this->m_FixedPointSet.empty() )
+    {
+      const std::string fixedPointSetFileName = temporaryDirectory->GetPath() + "/fixedPointSet.txt";
+      WritePointSetFile( fixedPointSetFileName, this->m_FixedPointSet, TMovingImage::ImageDimension );
+      transformixFilter->SetFixedPointSetFileName( fixedPointSetFileName );
+    }
+
     transformixFilter->SetLogFileName( this->GetLogFileName() );
     transformixFilter->SetLogToFile( this->GetLogToFile() );
     transformixFilter->SetLogToConsole( this->GetLogToConsole() );
 
-    ParameterMapVectorType transformParameterMapVector = this->m_TransformParameterMapVector;
-    for( unsigned int i = 0; i < transformParameterMapVector.size(); i++ )
+    // The parameter object keeps its own copy, so the overrides are set on
+    // the stored maps only while they are handed over
+    ParameterObjectPointer parameterObject = ParameterObjectType::New();
+    std::string resultImageFormat = "mhd";
     {
-      transformParameterMapVector[ i ][ "FixedInternalImagePixelType" ] = ParameterValueVectorType( 1, "float" );
-      transformParameterMapVector[ i ][ "MovingInternalImagePixelType" ] = ParameterValueVectorType( 1, "float" );
+      ParameterMapOverride parameterMapOverride( this->m_TransformParameterMapVector );
+      parameterMapOverride.Set( "FixedInternalImagePixelType", "float" );
+      parameterMapOverride.Set( "MovingInternalImagePixelType", "float" );
+
+      // Uncompressed single-file images are the cheapest to read back
+      if( temporaryDirectory.get() && resultDirectory == temporaryDirectory->GetPath() )
+      {
+        parameterMapOverride.Set( "ResultImageFormat", "mha" );
+        parameterMapOverride.Set( "CompressResultImage", "false" );
+      }
+
+      // Transformix writes result images in the format of the last map,
+      // and defaults to mhd
+      if( !this->m_TransformParameterMapVector.empty() )
+      {
+        const ParameterMapType& lastParameterMap = this->m_TransformParameterMapVector.back();
+        ParameterMapConstIterator formatIt = lastParameterMap.find( "ResultImageFormat" );
+        if( formatIt != lastParameterMap.end() && !formatIt->second.empty() )
+        {
+          resultImageFormat = formatIt->second[ 0 ];
+        }
+      }
+
+      parameterObject->SetParameterMap( this->m_TransformParameterMapVector );
     }
-
-    ParameterObjectPointer parameterObject = ParameterObjectType::New();
-    parameterObject->SetParameterMap( transformParameterMapVector );
     transformixFilter->SetTransformParameterObject( parameterObject );
+
+    // Connect commands, progress reporting, abort and number of threads
+    this->m_TransformixImageFilter->PreUpdate( transformixFilter.GetPointer() );
+
     transformixFilter->Update();
 
+    if( transformixFilter->GetAbortGenerateData() )
+    {
+      sitkExceptionMacro( "Transformation was aborted." );
+    }
+
+    typedef itk::Image< float, TMovingImage::ImageDimension >        ScalarImageType;
+    typedef itk::VectorImage< float, TMovingImage::ImageDimension >  VectorImageType;
+
+    this->m_ResultPointSet.clear();
+    if( !this->m_FixedPointSet.empty() || !this->GetFixedPointSetFileName().empty() )
+    {
+      this->m_ResultPointSet = ReadOutputPointSetFile( resultDirectory + "/outputpoints.txt" );
+    }
+
+    this->m_DeformationField = Image();
+    if( this->GetComputeDeformationField() )
+    {
+      this->m_DeformationField = this->ReadResultImage< VectorImageType >( resultDirectory + "/deformationField." + resultImageFormat );
+    }
+
+    this->m_SpatialJacobian = Image();
+    if( this->GetComputeSpatialJacobian() )
+    {
+      this->m_SpatialJacobian = this->ReadResultImage< VectorImageType >( resultDirectory + "/fullSpatialJacobian." + resultImageFormat );
+    }
+
+    this->m_DeterminantOfSpatialJacobian = Image();
+    if( this->GetComputeDeterminantOfSpatialJacobian() )
+    {
+      this->m_DeterminantOfSpatialJacobian = this->ReadResultImage< ScalarImageType >( resultDirectory + "/spatialJacobian." + resultImageFormat );
+    }
+
     if( !this->IsEmpty( this->GetMovingImage() ) )
     {
-      this->m_ResultImage = Image( itkDynamicCastInDebugMode< TMovingImage * >( transformixFilter->GetOutput() ) );
-      this->m_ResultImage.MakeUnique();
+      // Take over the output buffer instead of copying it
+      typename TMovingImage::Pointer resultImage = transformixFilter->GetOutput();
+      resultImage->DisconnectPipeline();
+      this->m_ResultImage = Image( resultImage );
     }
   }
   catch( itk::ExceptionObject &e )
@@ -112,6 +360,143 @@ TransformixImageFilter::TransformixImageFilterImpl
   return this->m_ResultImage;
 }
 
+template< typename TMovingImage >
+void
+TransformixImageFilter::TransformixImageFilterImpl
+::WriteResultImageInternal( void )
+{
+  typedef TransformixStreamingSource< TMovingImage, Self >  StreamingSourceType;
+  typedef itk::ImageFileWriter< TMovingImage >              WriterType;
+
+  const unsigned int Dimension = TMovingImage::ImageDimension;
+
+  if( this->IsEmpty( this->GetMovingImage() ) )
+  {
+    sitkExceptionMacro( "A moving image is required to write the result image to file." );
+  }
+
+  if( !this->m_FixedPointSet.empty() || !this->GetFixedPointSetFileName().empty()
+    || this->GetComputeDeformationField() || this->GetComputeSpatialJacobian() || this->GetComputeDeterminantOfSpatialJacobian() )
+  {
+    sitkExceptionMacro( "Point sets, deformation fields and spatial Jacobians can not be computed while the result image is written to file." );
+  }
+
+  if( this->m_TransformParameterMapVector.empty() )
+  {
+    sitkExceptionMacro( "Transform parameter map is empty." );
+  }
+
+  // Transformix resamples on the output grid of the last transform parameter map
+  const ParameterMapType& transformParameterMap = this->m_TransformParameterMapVector.back();
+  const std::vector< double > size = GetOutputGeometry( transformParameterMap, "Size", Dimension );
+  const std::vector< double > index = GetOutputGeometry( transformParameterMap, "Index", Dimension );
+  const std::vector< double > spacing = GetOutputGeometry( transformParameterMap, "Spacing", Dimension );
+  const std::vector< double > origin = GetOutputGeometry( transformParameterMap, "Origin", Dimension );
+  const std::vector< double > direction = GetOutputGeometry( transformParameterMap, "Direction", Dimension * Dimension );
+
+  typename TMovingImage::RegionType outputRegion;
+  typename TMovingImage::SpacingType outputSpacing;
+  typename TMovingImage::PointType outputOrigin;
+  typename TMovingImage::DirectionType outputDirection;
+  for( unsigned int i = 0; i < Dimension; ++i )
+  {
+    outputRegion.SetIndex( i, static_cast< typename TMovingImage::IndexValueType >( index[ i ] ) );
+    outputRegion.SetSize( i, static_cast< typename TMovingImage::SizeValueType >( size[ i ] ) );
+    outputSpacing[ i ] = spacing[ i ];
+    outputOrigin[ i ] = origin[ i ];
+
+    // Elastix writes the direction cosines column-major
+    for( unsigned int j = 0; j < Dimension; ++j )
+    {
+      outputDirection[ i ][ j ] = direction[ j * Dimension + i ];
+    }
+  }
+
+  typename StreamingSourceType::Pointer streamingSource = StreamingSourceType::New();
+  streamingSource->SetOwner( this );
+  streamingSource->SetOutputRegion( outputRegion );
+  streamingSource->SetOutputSpacing( outputSpacing );
+  streamingSource->SetOutputOrigin( outputOrigin );
+  streamingSource->SetOutputDirection( outputDirection );
+
+  // The writer requests one slab at a time if the file format supports
+  // streamed writing, and the whole image otherwise
+  typename WriterType::Pointer writer = WriterType::New();
+  writer->SetInput( streamingSource->GetOutput() );
+  writer->SetFileName( this->GetResultImageFileName() );
+  writer->SetNumberOfStreamDivisions( this->GetNumberOfStreamDivisions() );
+  writer->UseCompressionOff();
+
+  // Commands and progress are connected to the writer, which reports progress over all slabs
+  this->m_TransformixImageFilter->PreUpdate( writer.GetPointer() );
+
+  // The moving image is shared by the transformations of all slabs
+  this->m_StreamingMovingImage = this->GetITKImage< TMovingImage >( this->GetMovingImage() ).GetPointer();
+  try
+  {
+    writer->Update();
+  }
+  catch( ... )
+  {
+    this->m_StreamingMovingImage = 0;
+    throw;
+  }
+  this->m_StreamingMovingImage = 0;
+
+  if( writer->GetAbortGenerateData() )
+  {
+    sitkExceptionMacro( "Transformation was aborted." );
+  }
+
+  this->m_ResultImage = Image();
+  this->m_ResultPointSet.clear();
+  this->m_DeformationField = Image();
+  this->m_SpatialJacobian = Image();
+  this->m_DeterminantOfSpatialJacobian = Image();
+}
+
+template< typename TMovingImage >
+typename TMovingImage::Pointer
+TransformixImageFilter::TransformixImageFilterImpl
+::TransformRegion( const typename TMovingImage::RegionType& region )
+{
+  typedef elastix::TransformixFilter< TMovingImage > TransformixFilterType;
+
+  typename TransformixFilterType::Pointer transformixFilter = TransformixFilterType::New();
+  transformixFilter->SetMovingImage( itkDynamicCastInDebugMode< TMovingImage* >( this->m_StreamingMovingImage.GetPointer() ) );
+  transformixFilter->SetOutputDirectory( "" );
+  transformixFilter->SetLogFileName( this->GetLogFileName() );
+  transformixFilter->SetLogToFile( this->GetLogToFile() );
+  transformixFilter->SetLogToConsole( this->GetLogToConsole() );
+
+  ParameterValueVectorType size, index;
+  for( unsigned int i = 0; i < TMovingImage::ImageDimension; ++i )
+  {
+    std::ostringstream sizeValue, indexValue;
+    sizeValue << region.GetSize( i );
+    indexValue << region.GetIndex( i );
+    size.push_back( sizeValue.str() );
+    index.push_back( indexValue.str() );
+  }
+
+  // Restrict the output grid to the region. Origin, spacing and direction
+  // are unchanged, so the region is resampled exactly as in the full image.
+  ParameterObjectPointer parameterObject = ParameterObjectType::New();
+  {
+    ParameterMapOverride parameterMapOverride( this->m_TransformParameterMapVector );
+    parameterMapOverride.Set( "FixedInternalImagePixelType", "float" );
+    parameterMapOverride.Set( "MovingInternalImagePixelType", "float" );
+    parameterMapOverride.Set( "Size", size );
+    parameterMapOverride.Set( "Index", index );
+    parameterObject->SetParameterMap( this->m_TransformParameterMapVector );
+  }
+
+  transformixFilter->SetTransformParameterObject( parameterObject );
+  transformixFilter->Update();
+
+  return transformixFilter->GetOutput();
+}
+
 const std::string 
 TransformixImageFilter::TransformixImageFilterImpl
 ::GetName( void )
@@ -143,23 +528,46 @@ TransformixImageFilter::TransformixImageFilterImpl
 
 void 
 TransformixImageFilter::TransformixImageFilterImpl
-::SetFixedPointSetFileName( const std::string movingPointSetFileName )
+::SetFixedPointSetFileName( const std::string fixedPointSetFileName )
 {
-  this->m_MovingPointSetFileName = movingPointSetFileName;
+  this->m_FixedPointSet.clear();
+  this->m_FixedPointSetFileName = fixedPointSetFileName;
 }
 
 std::string 
 TransformixImageFilter::TransformixImageFilterImpl
 ::GetFixedPointSetFileName( void )
 {
-  return this->m_MovingPointSetFileName;
+  return this->m_FixedPointSetFileName;
 }
 
 void
 TransformixImageFilter::TransformixImageFilterImpl
 ::RemoveFixedPointSetFileName( void )
 {
-  this->m_MovingPointSetFileName = std::string();
+  this->m_FixedPointSetFileName = std::string();
+}
+
+void 
+TransformixImageFilter::TransformixImageFilterImpl
+::SetFixedPointSet( const std::vector< double >& fixedPointSet )
+{
+  this->m_FixedPointSetFileName = std::string();
+  this->m_FixedPointSet = fixedPointSet;
+}
+
+std::vector< double >
+TransformixImageFilter::TransformixImageFilterImpl
+::GetFixedPointSet( void )
+{
+  return this->m_FixedPointSet;
+}
+
+void
+TransformixImageFilter::TransformixImageFilterImpl
+::RemoveFixedPointSet( void )
+{
+  this->m_FixedPointSet.clear();
 }
 
 void
@@ -270,6 +678,46 @@ TransformixImageFilter::TransformixImageFilterImpl
   this->m_OutputDirectory = std::string();
 }
 
+void
+TransformixImageFilter::TransformixImageFilterImpl
+::SetResultImageFileName( const std::string resultImageFileName )
+{
+  this->m_ResultImageFileName = resultImageFileName;
+}
+
+std::string
+TransformixImageFilter::TransformixImageFilterImpl
+::GetResultImageFileName( void )
+{
+  return this->m_ResultImageFileName;
+}
+
+void
+TransformixImageFilter::TransformixImageFilterImpl
+::RemoveResultImageFileName( void )
+{
+  this->m_ResultImageFileName = std::string();
+}
+
+void
+TransformixImageFilter::TransformixImageFilterImpl
+::SetNumberOfStreamDivisions( const unsigned int numberOfStreamDivisions )
+{
+  if( numberOfStreamDivisions == 0 )
+  {
+    sitkExceptionMacro( "Number of stream divisions must be at least 1." );
+  }
+
+  this->m_NumberOfStreamDivisions = numberOfStreamDivisions;
+}
+
+unsigned int
+TransformixImageFilter::TransformixImageFilterImpl
+::GetNumberOfStreamDivisions( void )
+{
+  return this->m_NumberOfStreamDivisions;
+}
+
 void 
 TransformixImageFilter::TransformixImageFilterImpl
 ::SetLogFileName( std::string logFileName )
@@ -350,14 +798,14 @@ TransformixImageFilter::TransformixImageFilterImpl
 
 void
 TransformixImageFilter::TransformixImageFilterImpl
-::SetTransformParameterMap( const ParameterMapVectorType parameterMapVector )
+::SetTransformParameterMap( const ParameterMapVectorType& parameterMapVector )
 {
   this->m_TransformParameterMapVector = parameterMapVector;
 }
 
 void
 TransformixImageFilter::TransformixImageFilterImpl
-::SetTransformParameterMap( const ParameterMapType parameterMap )
+::SetTransformParameterMap( const ParameterMapType& parameterMap )
 {
   ParameterMapVectorType parameterMapVector;
   parameterMapVector.push_back( parameterMap );
@@ -367,12 +815,12 @@ TransformixImageFilter::TransformixImageFilterImpl
 
 void
 TransformixImageFilter::TransformixImageFilterImpl
-::AddTransformParameterMap( const ParameterMapType parameterMap )
+::AddTransformParameterMap( const ParameterMapType& parameterMap )
 {
   this->m_TransformParameterMapVector.push_back( parameterMap );
 }
 
-TransformixImageFilter::TransformixImageFilterImpl::ParameterMapVectorType
+const TransformixImageFilter::TransformixImageFilterImpl::ParameterMapVectorType&
 TransformixImageFilter::TransformixImageFilterImpl
 ::GetTransformParameterMap( void )
 {
@@ -398,7 +846,7 @@ TransformixImageFilter::TransformixImageFilterImpl
 
 void
 TransformixImageFilter::TransformixImageFilterImpl
-::SetTransformParameter( const ParameterKeyType key, const ParameterValueVectorType value )
+::SetTransformParameter( const ParameterKeyType key, const ParameterValueVectorType& value )
 {
   for( unsigned int i = 0; i < this->m_TransformParameterMapVector.size(); i++ )
   {
@@ -420,7 +868,7 @@ TransformixImageFilter::TransformixImageFilterImpl
 
 void
 TransformixImageFilter::TransformixImageFilterImpl
-::SetTransformParameter( const unsigned int index, const ParameterKeyType key, const ParameterValueVectorType value )
+::SetTransformParameter( const unsigned int index, const ParameterKeyType key, const ParameterValueVectorType& value )
 {
   if( index >= this->m_TransformParameterMapVector.size() )
   {
@@ -525,7 +973,7 @@ TransformixImageFilter::TransformixImageFilterImpl
 
 void
 TransformixImageFilter::TransformixImageFilterImpl
-::WriteParameterFile( const ParameterMapType parameterMap, const std::string parameterFileName )
+::WriteParameterFile( const ParameterMapType& parameterMap, const std::string parameterFileName )
 {
   ParameterObjectPointer parameterObject = ParameterObjectType::New();
   parameterObject->WriteParameterFile( parameterMap, parameterFileName );
@@ -540,7 +988,7 @@ TransformixImageFilter::TransformixImageFilterImpl
 
 void 
 TransformixImageFilter::TransformixImageFilterImpl
-::PrintParameterMap( const ParameterMapType parameterMap )
+::PrintParameterMap( const ParameterMapType& parameterMap )
 {
   ParameterMapVectorType parameterMapVector = ParameterMapVectorType( 1 );
   parameterMapVector[ 0 ] = parameterMap;
@@ -549,7 +997,7 @@ TransformixImageFilter::TransformixImageFilterImpl
 
 void 
 TransformixImageFilter::TransformixImageFilterImpl
-::PrintParameterMap( const ParameterMapVectorType parameterMapVector )
+::PrintParameterMap( const ParameterMapVectorType& parameterMapVector )
 {
   ParameterObjectPointer parameterObject = ParameterObjectType::New();
   parameterObject->SetParameterMap( parameterMapVector );
@@ -557,6 +1005,47 @@ TransformixImageFilter::TransformixImageFilterImpl
   
 }
 
+void
+TransformixImageFilter::TransformixImageFilterImpl
+::ExecuteAsync( void )
+{
+  this->m_AsyncExecution.Start();
+}
+
+Image
+TransformixImageFilter::TransformixImageFilterImpl
+::Wait( void )
+{
+  this->m_AsyncExecution.Wait();
+
+  // Empty if only a point set was transformed
+  return this->m_ResultImage;
+}
+
+bool
+TransformixImageFilter::TransformixImageFilterImpl
+::IsDone( void )
+{
+  return this->m_AsyncExecution.IsDone();
+}
+
+void
+TransformixImageFilter::TransformixImageFilterImpl
+::Cancel( void )
+{
+  this->m_AsyncExecution.Cancel();
+}
+
+void
+TransformixImageFilter::TransformixImageFilterImpl
+::CheckNotExecutingAsync( void )
+{
+  if( this->m_AsyncExecution.IsStarted() )
+  {
+    sitkExceptionMacro( "The filter can not be used while an asynchronous execution is running. Call Wait() first." );
+  }
+}
+
 Image
 TransformixImageFilter::TransformixImageFilterImpl
 ::GetResultImage( void )
@@ -569,6 +1058,81 @@ TransformixImageFilter::TransformixImageFilterImpl
   return this->m_ResultImage;
 }
 
+Image
+TransformixImageFilter::TransformixImageFilterImpl
+::MoveResultImage( void )
+{
+  Image resultImage = this->GetResultImage();
+  this->m_ResultImage = Image();
+  return resultImage;
+}
+
+std::vector< double >
+TransformixImageFilter::TransformixImageFilterImpl
+::GetResultPointSet( void )
+{
+  if( this->m_ResultPointSet.empty() )
+  {
+    sitkExceptionMacro( "No result point set was found. Set a fixed point set and run transformix with Execute()." )
+  }
+
+  return this->m_ResultPointSet;
+}
+
+Image
+TransformixImageFilter::TransformixImageFilterImpl
+::GetDeformationField( void )
+{
+  if( this->IsEmpty( this->m_DeformationField ) )
+  {
+    sitkExceptionMacro( "No deformation field was found. Enable ComputeDeformationField and run transformix with Execute()." )
+  }
+
+  return this->m_DeformationField;
+}
+
+Image
+TransformixImageFilter::TransformixImageFilterImpl
+::GetSpatialJacobian( void )
+{
+  if( this->IsEmpty( this->m_SpatialJacobian ) )
+  {
+    sitkExceptionMacro( "No spatial Jacobian was found. Enable ComputeSpatialJacobian and run transformix with Execute()." )
+  }
+
+  return this->m_SpatialJacobian;
+}
+
+Image
+TransformixImageFilter::TransformixImageFilterImpl
+::GetDeterminantOfSpatialJacobian( void )
+{
+  if( this->IsEmpty( this->m_DeterminantOfSpatialJacobian ) )
+  {
+    sitkExceptionMacro( "No determinant of spatial Jacobian was found. Enable ComputeDeterminantOfSpatialJacobian and run transformix with Execute()." )
+  }
+
+  return this->m_DeterminantOfSpatialJacobian;
+}
+
+template< typename TImage >
+Image
+TransformixImageFilter::TransformixImageFilterImpl
+::ReadResultImage( const std::string fileName )
+{
+  // Only the exact file is read, as the directory may hold other result
+  // images or files from earlier runs
+  if( !itksys::SystemTools::FileExists( fileName.c_str(), true ) )
+  {
+    sitkExceptionMacro( "Transformix did not write " << fileName << "." );
+  }
+
+  typedef itk::ImageFileReader< TImage > ReaderType;
+  typename ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName( fileName );
+  reader->Update();
+  return Image( reader->GetOutput() );
+}
 
 bool
 TransformixImageFilter::TransformixImageFilterImpl
@@ -578,6 +1142,23 @@ TransformixImageFilter::TransformixImageFilterImpl
   return isEmpty;
 }
 
+template< typename TImage >
+typename TImage::Pointer
+TransformixImageFilter::TransformixImageFilterImpl
+::GetITKImage( const Image& image )
+{
+  const PixelIDValueEnum pixelID = static_cast< PixelIDValueEnum >( ImageTypeToPixelIDValue< TImage >::Result );
+
+  if( image.GetPixelID() == pixelID )
+  {
+    // Transformix does not modify its input, so the buffer is shared rather than made unique
+    return const_cast< TImage* >( itkDynamicCastInDebugMode< const TImage* >( image.GetITKBase() ) );
+  }
+
+  Image castImage = Cast( image, pixelID );
+  return itkDynamicCastInDebugMode< TImage* >( castImage.GetITKBase() );
+}
+
 } // end namespace simple
 } // end namespace itk
 
@@ -4,6 +4,9 @@
 // SimpleITK
 #include "sitkTransformixImageFilter.h"
 #include "sitkMemberFunctionFactory.h"
+#include "sitkElastixAsyncExecution.h"
+#include "sitkParameterMapOverride.h"
+#include "sitkTransformixStreamingSource.h"
 
 // Transformix
 #include "elxTransformixFilter.h"
@@ -15,11 +18,13 @@ namespace itk {
 struct TransformixImageFilter::TransformixImageFilterImpl
 {
 
-  TransformixImageFilterImpl( void );
+  TransformixImageFilterImpl( TransformixImageFilter* transformixImageFilter );
   ~TransformixImageFilterImpl( void );
 
   typedef TransformixImageFilterImpl Self;
 
+  typedef TransformixImageFilter::VectorOfImage          VectorOfImage;
+
   typedef elastix::ParameterObject                       ParameterObjectType;
   typedef ParameterObjectType::Pointer                   ParameterObjectPointer;
   typedef ParameterObjectType::ParameterMapType          ParameterMapType;
@@ -42,6 +47,10 @@ struct TransformixImageFilter::TransformixImageFilterImpl
   std::string GetFixedPointSetFileName( void );
   void RemoveFixedPointSetFileName( void );
 
+  void SetFixedPointSet( const std::vector< double >& fixedPointSet );
+  std::vector< double > GetFixedPointSet( void );
+  void RemoveFixedPointSet( void );
+
   void SetComputeSpatialJacobian( const bool );
   bool GetComputeSpatialJacobian( void );
   void ComputeSpatialJacobianOn( void );
@@ -61,6 +70,12 @@ struct TransformixImageFilter::TransformixImageFilterImpl
   std::string GetOutputDirectory( void );
   void RemoveOutputDirectory( void );
 
+  void SetResultImageFileName( const std::string resultImageFileName );
+  std::string GetResultImageFileName( void );
+  void RemoveResultImageFileName( void );
+  void SetNumberOfStreamDivisions( const unsigned int numberOfStreamDivisions );
+  unsigned int GetNumberOfStreamDivisions( void );
+
   void SetLogFileName( const std::string logFileName );
   std::string GetLogFileName( void );
   void RemoveLogFileName( void );
@@ -75,16 +90,16 @@ struct TransformixImageFilter::TransformixImageFilterImpl
   void LogToConsoleOn();
   void LogToConsoleOff();
 
-  void SetTransformParameterMap( const std::vector< std::map< std::string, std::vector< std::string > > > parameterMapVector );
-  void SetTransformParameterMap( const std::map< std::string, std::vector< std::string > > parameterMap );
-  void AddTransformParameterMap( const std::map< std::string, std::vector< std::string > > parameterMap );
-  std::vector< std::map< std::string, std::vector< std::string > > > GetTransformParameterMap( void );
+  void SetTransformParameterMap( const std::vector< std::map< std::string, std::vector< std::string > > >& parameterMapVector );
+  void SetTransformParameterMap( const std::map< std::string, std::vector< std::string > >& parameterMap );
+  void AddTransformParameterMap( const std::map< std::string, std::vector< std::string > >& parameterMap );
+  const std::vector< std::map< std::string, std::vector< std::string > > >& GetTransformParameterMap( void );
   unsigned int GetNumberOfTransformParameterMaps( void );
 
   void SetTransformParameter( const std::string key, const std::string value );
-  void SetTransformParameter( const std::string key, const std::vector< std::string > value );
+  void SetTransformParameter( const std::string key, const std::vector< std::string >& value );
   void SetTransformParameter( const unsigned int index, const std::string key, const std::string value );
-  void SetTransformParameter( const unsigned int index, const std::string key, const std::vector< std::string > value );
+  void SetTransformParameter( const unsigned int index, const std::string key, const std::vector< std::string >& value );
   void AddTransformParameter( const std::string key, const std::string value );
   void AddTransformParameter( const unsigned int index, const std::string key, const std::string value );
   std::vector< std::string > GetTransformParameter( const std::string key );
@@ -93,37 +108,74 @@ struct TransformixImageFilter::TransformixImageFilterImpl
   void RemoveTransformParameter( const unsigned int index, const std::string key );
 
   std::map< std::string, std::vector< std::string > > ReadParameterFile( const std::string filename );
-  void WriteParameterFile( const std::map< std::string, std::vector< std::string > > parameterMap, const std::string parameterFileName );
+  void WriteParameterFile( const std::map< std::string, std::vector< std::string > >& parameterMap, const std::string parameterFileName );
 
   void PrintParameterMap( void );
-  void PrintParameterMap( const std::map< std::string, std::vector< std::string > > parameterMap );
-  void PrintParameterMap( const std::vector< std::map< std::string, std::vector< std::string > > > parameterMapVector );
+  void PrintParameterMap( const std::map< std::string, std::vector< std::string > >& parameterMap );
+  void PrintParameterMap( const std::vector< std::map< std::string, std::vector< std::string > > >& parameterMapVector );
 
   Image Execute( void );
+  VectorOfImage Execute( const VectorOfImage& movingImages );
+
+  void ExecuteAsync( void );
+  Image Wait( void );
+  bool IsDone( void );
+  void Cancel( void );
+
+  // Throws while an asynchronous execution has not been waited for, as
+  // the worker thread uses the filter's inputs and parameter maps
+  void CheckNotExecutingAsync( void );
 
   Image GetResultImage( void );
+  Image MoveResultImage( void );
+  std::vector< double > GetResultPointSet( void );
+  Image GetDeformationField( void );
+  Image GetSpatialJacobian( void );
+  Image GetDeterminantOfSpatialJacobian( void );
+
+  template< typename TImage > Image ReadResultImage( const std::string fileName );
 
   bool IsEmpty( const Image& image );
 
+  template< typename TImage > typename TImage::Pointer GetITKImage( const Image& image );
+
+  // Streams the result image to the result image file name, region by region
+  template< typename TMovingImage > void WriteResultImageInternal( void );
+  template< typename TMovingImage > typename TMovingImage::Pointer TransformRegion( const typename TMovingImage::RegionType& region );
+
   // Definitions for SimpleITK member factory
   typedef Image ( Self::*MemberFunctionType )( void );
   template< class TMovingImage > Image ExecuteInternal( void );
   friend struct detail::MemberFunctionAddressor< MemberFunctionType >;
   nsstd::auto_ptr< detail::MemberFunctionFactory< MemberFunctionType > > m_MemberFactory;
 
+  // The process object that owns this implementation. Commands, progress,
+  // abort and number of threads are forwarded to transformix through it.
+  TransformixImageFilter* m_TransformixImageFilter;
+  AsyncExecution< Self >  m_AsyncExecution;
+
   Image                   m_MovingImage;
   Image                   m_ResultImage;
+  Image                   m_DeformationField;
+  Image                   m_SpatialJacobian;
+  Image                   m_DeterminantOfSpatialJacobian;
 
   ParameterMapVectorType  m_TransformParameterMapVector;
 
   bool                    m_ComputeSpatialJacobian;
   bool                    m_ComputeDeterminantOfSpatialJacobian;
   bool                    m_ComputeDeformationField;
-  std::string             m_MovingPointSetFileName;
+  std::string             m_FixedPointSetFileName;
+  std::vector< double >   m_FixedPointSet;
+  std::vector< double >   m_ResultPointSet;
 
   std::string             m_OutputDirectory;
   std::string             m_LogFileName;
 
+  std::string             m_ResultImageFileName;
+  unsigned int            m_NumberOfStreamDivisions;
+  DataObject::Pointer     m_StreamingMovingImage;
+
   bool                    m_LogToConsole;
   bool                    m_LogToFile;
 };
@@ -0,0 +1,76 @@
+#ifndef __sitktransformixstreamingsource_h_
+#define __sitktransformixstreamingsource_h_
+
+#include "itkImageSource.h"
+
+namespace itk {
+  namespace simple {
+
+// Produces the requested region of the transformix result image only, so
+// that a streaming writer downstream resamples the output one slab at a
+// time. The output geometry is that of the transform parameter maps and
+// TOwner::TransformRegion< TOutputImage >( region ) resamples a region.
+template< typename TOutputImage, typename TOwner >
+class TransformixStreamingSource : public ImageSource< TOutputImage >
+{
+public:
+
+  typedef TransformixStreamingSource        Self;
+  typedef ImageSource< TOutputImage >       Superclass;
+  typedef SmartPointer< Self >              Pointer;
+  typedef SmartPointer< const Self >        ConstPointer;
+
+  itkNewMacro( Self );
+  itkTypeMacro( TransformixStreamingSource, ImageSource );
+
+  typedef typename TOutputImage::RegionType     RegionType;
+  typedef typename TOutputImage::SpacingType    SpacingType;
+  typedef typename TOutputImage::PointType      PointType;
+  typedef typename TOutputImage::DirectionType  DirectionType;
+
+  void SetOwner( TOwner* owner ) { this->m_Owner = owner; }
+
+  itkSetMacro( OutputRegion, RegionType );
+  itkSetMacro( OutputSpacing, SpacingType );
+  itkSetMacro( OutputOrigin, PointType );
+  itkSetMacro( OutputDirection, DirectionType );
+
+protected:
+
+  TransformixStreamingSource( void ) : m_Owner( 0 ) {}
+
+  virtual void GenerateOutputInformation( void )
+  {
+    TOutputImage* output = this->GetOutput();
+    output->SetLargestPossibleRegion( this->m_OutputRegion );
+    output->SetSpacing( this->m_OutputSpacing );
+    output->SetOrigin( this->m_OutputOrigin );
+    output->SetDirection( this->m_OutputDirection );
+  }
+
+  virtual void GenerateData( void )
+  {
+    // The buffer of the resampled region is handed over without a copy
+    TOutputImage* output = this->GetOutput();
+    const RegionType region = output->GetRequestedRegion();
+    typename TOutputImage::Pointer resampledRegion = this->m_Owner->template TransformRegion< TOutputImage >( region );
+    output->SetBufferedRegion( region );
+    output->SetPixelContainer( resampledRegion->GetPixelContainer() );
+  }
+
+private:
+
+  TransformixStreamingSource( const Self& );
+  void operator=( const Self& );
+
+  TOwner*         m_Owner;
+  RegionType      m_OutputRegion;
+  SpacingType     m_OutputSpacing;
+  PointType       m_OutputOrigin;
+  DirectionType   m_OutputDirection;
+};
+
+} // end namespace simple
+} // end namespace itk
+
+#endif // __sitktransformixstreamingsource_h_
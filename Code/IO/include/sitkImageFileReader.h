@@ -50,6 +50,51 @@ namespace itk {
       SITK_RETURN_SELF_TYPE_HEADER SetFileName ( const std::string &fn );
       std::string GetFileName() const;
 
+      /** \brief Read only a region of the image into memory
+       *
+       * When the BufferedRegionSize is not empty only the region
+       * starting at BufferedRegionIndex with this size is read. The
+       * returned image has the size of the whole image in the file,
+       * while only the region is buffered. This enables processing
+       * images larger than memory slab by slab. If the ImageIO for
+       * the file does not support streaming, the whole image is
+       * read.
+       *
+       * The default empty BufferedRegionSize reads the whole image.
+       *
+       * \sa Image::GetBufferedIndex
+       * @{ */
+      SITK_RETURN_SELF_TYPE_HEADER SetBufferedRegionIndex( const std::vector<unsigned int> &index );
+      std::vector<unsigned int> GetBufferedRegionIndex() const;
+
+      SITK_RETURN_SELF_TYPE_HEADER SetBufferedRegionSize( const std::vector<unsigned int> &size );
+      std::vector<unsigned int> GetBufferedRegionSize() const;
+      /** @} */
+
+      /** \brief Map the pixels of the file into memory instead of reading them
+       *
+       * When enabled, the pixel data of uncompressed MetaImage and NRRD
+       * files is mapped copy-on-write, so opening a large file is
+       * immediate and its pages are shared through the page cache with
+       * other processes mapping the same file. Modifying the pixels
+       * makes private copies of the modified pages, the file is never
+       * changed.
+       *
+       * Files which can not be mapped are read as usual. This includes
+       * compressed files, a byte order other than the system's, an
+       * OutputPixelType other than the file's, a BufferedRegionSize,
+       * and pixel data which is not aligned to the pixel component
+       * size in the file.
+       *
+       * By default memory mapping is off.
+       * @{ */
+      SITK_RETURN_SELF_TYPE_HEADER SetUseMemoryMapping( bool useMemoryMapping );
+      bool GetUseMemoryMapping( void ) const;
+
+      SITK_RETURN_SELF_TYPE_HEADER UseMemoryMappingOn( void ) { return this->SetUseMemoryMapping(true); }
+      SITK_RETURN_SELF_TYPE_HEADER UseMemoryMappingOff( void ) { return this->SetUseMemoryMapping(false); }
+      /** @} */
+
       Image Execute();
 
       ImageFileReader();
@@ -68,6 +113,11 @@ namespace itk {
       nsstd::auto_ptr<detail::MemberFunctionFactory<MemberFunctionType> > m_MemberFactory;
 
       std::string m_FileName;
+
+      std::vector<unsigned int> m_BufferedRegionIndex;
+      std::vector<unsigned int> m_BufferedRegionSize;
+
+      bool m_UseMemoryMapping;
     };
 
   /**
@@ -43,6 +43,12 @@ class SmartPointer;
      * location specified in FileName. If writing fails, an ITK exception is
      * thrown.
      *
+     * When the image is not fully buffered only its buffered region
+     * is written into the corresponding region of the file. This
+     * requires an ImageIO which supports streamed writing, such as
+     * MetaImage, and compression to be off, so that an image larger
+     * than memory can be written slab by slab.
+     *
      * \sa itk::simple::WriteImage for the procedural interface
      */
     class SITKIO_EXPORT ImageFileWriter  :
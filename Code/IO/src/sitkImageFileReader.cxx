@@ -20,13 +20,281 @@
 #endif
 
 #include "sitkImageFileReader.h"
+#include "sitkMemoryMappedImageContainer.h"
 
 #include <itkImageFileReader.h>
+#include <itkVectorImage.h>
+#include <itkByteSwapper.h>
+#include <itksys/SystemTools.hxx>
+
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
 
 
 namespace itk {
   namespace simple {
 
+  namespace
+  {
+
+  std::string TrimWhitespace( const std::string &s )
+  {
+    const std::string whitespace = " \t\r";
+    const std::string::size_type first = s.find_first_not_of( whitespace );
+    if ( first == std::string::npos )
+      {
+      return std::string();
+      }
+    return s.substr( first, s.find_last_not_of( whitespace ) - first + 1 );
+  }
+
+  uint64_t GetFileLength( const std::string &fileName )
+  {
+    std::ifstream file( fileName.c_str(), std::ios::in | std::ios::binary );
+    file.seekg( 0, std::ios::end );
+    return file ? static_cast<uint64_t>( file.tellg() ) : 0;
+  }
+
+  // Finds the raw pixel data of a MetaImage header. The element data
+  // file is the last field of the header.
+  bool GetMetaImagePixelDataLocation( const std::string &fileName,
+                                      uint64_t pixelDataLength,
+                                      std::string &dataFileName,
+                                      uint64_t &dataOffset )
+  {
+    std::ifstream header( fileName.c_str(), std::ios::in | std::ios::binary );
+    std::string line;
+    bool compressed = false;
+    bool binary = true;
+    int64_t headerSize = 0;
+    while ( std::getline( header, line ) )
+      {
+      const std::string::size_type separator = line.find( '=' );
+      if ( separator == std::string::npos )
+        {
+        continue;
+        }
+      const std::string key = TrimWhitespace( line.substr( 0, separator ) );
+      const std::string value = TrimWhitespace( line.substr( separator + 1 ) );
+
+      if ( key == "CompressedData" )
+        {
+        compressed = ( value == "True" || value == "true" );
+        }
+      else if ( key == "BinaryData" )
+        {
+        binary = ( value == "True" || value == "true" );
+        }
+      else if ( key == "HeaderSize" )
+        {
+        headerSize = atol( value.c_str() );
+        }
+      else if ( key == "ElementDataFile" )
+        {
+        if ( compressed || !binary )
+          {
+          return false;
+          }
+
+        if ( value == "LOCAL" )
+          {
+          dataFileName = fileName;
+          dataOffset = static_cast<uint64_t>( header.tellg() );
+          return true;
+          }
+
+        // lists and patterns of slice files can not be mapped
+        if ( value.find( "LIST" ) == 0 || value.find( ' ' ) != std::string::npos || value.find( '%' ) != std::string::npos )
+          {
+          return false;
+          }
+
+        dataFileName = itksys::SystemTools::CollapseFullPath( value, itksys::SystemTools::GetFilenamePath( fileName ) );
+        if ( headerSize >= 0 )
+          {
+          dataOffset = static_cast<uint64_t>( headerSize );
+          }
+        else
+          {
+          // the pixel data is at the end of the file
+          dataOffset = GetFileLength( dataFileName ) - pixelDataLength;
+          }
+        return true;
+        }
+      }
+
+    return false;
+  }
+
+  // NRRD axis kinds of the image domain. Other kinds mark the axis
+  // holding the components of a pixel.
+  bool IsNrrdDomainKind( const std::string &kind )
+  {
+    return kind == "domain" || kind == "space" || kind == "time" || kind == "???" || kind == "none";
+  }
+
+  // Finds the raw pixel data of a NRRD file with attached data, which
+  // starts after the blank line ending the header. NrrdImageIO moves
+  // the axis of the pixel components to be fastest, so only files in
+  // which it already is can be mapped.
+  bool GetNrrdPixelDataLocation( const std::string &fileName,
+                                 unsigned int imageDimension,
+                                 unsigned int numberOfComponents,
+                                 std::string &dataFileName,
+                                 uint64_t &dataOffset )
+  {
+    std::ifstream header( fileName.c_str(), std::ios::in | std::ios::binary );
+    std::string line;
+    if ( !std::getline( header, line ) || line.find( "NRRD" ) != 0 )
+      {
+      return false;
+      }
+
+    bool raw = false;
+    unsigned int dimension = 0;
+    std::vector<std::string> kinds;
+    while ( std::getline( header, line ) )
+      {
+      line = TrimWhitespace( line );
+      if ( line.empty() )
+        {
+        if ( !raw )
+          {
+          return false;
+          }
+        if ( dimension == imageDimension )
+          {
+          if ( numberOfComponents != 1 )
+            {
+            return false;
+            }
+          }
+        else if ( dimension != imageDimension + 1
+                  || kinds.size() != dimension
+                  || IsNrrdDomainKind( kinds[0] ) )
+          {
+          return false;
+          }
+        dataFileName = fileName;
+        dataOffset = static_cast<uint64_t>( header.tellg() );
+        return true;
+        }
+
+      const std::string::size_type separator = line.find( ": " );
+      if ( line[0] == '#' || separator == std::string::npos )
+        {
+        continue;
+        }
+      const std::string field = line.substr( 0, separator );
+      const std::string value = TrimWhitespace( line.substr( separator + 2 ) );
+
+      if ( field == "encoding" )
+        {
+        raw = ( value == "raw" );
+        }
+      else if ( field == "dimension" )
+        {
+        dimension = static_cast<unsigned int>( atoi( value.c_str() ) );
+        }
+      else if ( field == "kinds" )
+        {
+        std::istringstream kindStream( value );
+        std::string kind;
+        kinds.clear();
+        while ( kindStream >> kind )
+          {
+          kinds.push_back( kind );
+          }
+        }
+      else if ( field == "data file" || field == "datafile"
+                || ( ( field == "line skip" || field == "lineskip"
+                       || field == "byte skip" || field == "byteskip" ) && value != "0" ) )
+        {
+        // detached or offset pixel data is read as usual
+        return false;
+        }
+      }
+
+    return false;
+  }
+
+  template< class TImageType >
+  void SetNumberOfComponentsPerPixel( TImageType *, unsigned int )
+  {
+  }
+
+  template< class TPixelType, unsigned int VImageDimension >
+  void SetNumberOfComponentsPerPixel( itk::VectorImage< TPixelType, VImageDimension > *image, unsigned int numberOfComponents )
+  {
+    image->SetNumberOfComponentsPerPixel( numberOfComponents );
+  }
+
+  // Returns the output image of the reader with its pixel buffer mapped
+  // from the file, or NULL if the file can not be mapped.
+  template< class TImageType >
+  typename TImageType::Pointer MapImage( itk::ImageFileReader< TImageType > *reader,
+                                         itk::ImageIOBase *imageio,
+                                         const std::string &fileName )
+  {
+    typedef typename TImageType::PixelContainer            PixelContainerType;
+    typedef typename PixelContainerType::Element            ElementType;
+    typedef MemoryMappedImageContainer< typename PixelContainerType::ElementIdentifier, ElementType > MappedContainerType;
+
+    const std::string imageIOName = imageio->GetNameOfClass();
+    if ( imageIOName != "MetaImageIO" && imageIOName != "NrrdImageIO" )
+      {
+      return SITK_NULLPTR;
+      }
+
+    const bool fileIsBigEndian = imageio->GetByteOrder() == itk::ImageIOBase::BigEndian;
+    const bool fileIsLittleEndian = imageio->GetByteOrder() == itk::ImageIOBase::LittleEndian;
+    if ( imageio->GetComponentSize() > 1
+         && ( ( fileIsBigEndian && !itk::ByteSwapper<int>::SystemIsBigEndian() )
+              || ( fileIsLittleEndian && itk::ByteSwapper<int>::SystemIsBigEndian() ) ) )
+      {
+      return SITK_NULLPTR;
+      }
+
+    const uint64_t pixelDataLength = imageio->GetImageSizeInBytes();
+    std::string dataFileName;
+    uint64_t dataOffset = 0;
+    if ( imageIOName == "MetaImageIO" ?
+         !GetMetaImagePixelDataLocation( fileName, pixelDataLength, dataFileName, dataOffset ) :
+         !GetNrrdPixelDataLocation( fileName, imageio->GetNumberOfDimensions(), imageio->GetNumberOfComponents(),
+                                    dataFileName, dataOffset ) )
+      {
+      return SITK_NULLPTR;
+      }
+
+    // Unaligned pixels and truncated files are read as usual
+    if ( pixelDataLength % sizeof( ElementType ) != 0
+         || dataOffset % imageio->GetComponentSize() != 0
+         || GetFileLength( dataFileName ) < dataOffset + pixelDataLength )
+      {
+      return SITK_NULLPTR;
+      }
+
+    typename MappedContainerType::Pointer container = MappedContainerType::New();
+    if ( !container->Map( dataFileName, dataOffset, pixelDataLength / sizeof( ElementType ) ) )
+      {
+      return SITK_NULLPTR;
+      }
+
+    reader->UpdateOutputInformation();
+    typename TImageType::Pointer image = reader->GetOutput();
+    image->DisconnectPipeline();
+
+    SetNumberOfComponentsPerPixel( image.GetPointer(), imageio->GetNumberOfComponents() );
+    image->SetBufferedRegion( image->GetLargestPossibleRegion() );
+    image->SetRequestedRegion( image->GetLargestPossibleRegion() );
+    image->SetPixelContainer( container );
+
+    return image;
+  }
+
+  }
+
   Image ReadImage ( const std::string &filename, PixelIDValueEnum outputPixelType )
     {
       ImageFileReader reader;
@@ -34,6 +302,7 @@ namespace itk {
     }
 
     ImageFileReader::ImageFileReader()
+      : m_UseMemoryMapping( false )
       {
       // list of pixel types supported
       typedef NonLabelPixelIDTypeList PixelIDTypeList;
@@ -52,6 +321,10 @@ namespace itk {
       out << std::endl;
       out << "  FileName: \"";
       this->ToStringHelper(out, this->m_FileName) << "\"" << std::endl;
+      out << "  BufferedRegionIndex: " << this->m_BufferedRegionIndex << std::endl;
+      out << "  BufferedRegionSize: " << this->m_BufferedRegionSize << std::endl;
+      out << "  UseMemoryMapping: ";
+      this->ToStringHelper(out, this->m_UseMemoryMapping) << std::endl;
 
       out << ImageReaderBase::ToString();
       return out.str();
@@ -66,6 +339,33 @@ namespace itk {
       return this->m_FileName;
     }
 
+    ImageFileReader& ImageFileReader::SetBufferedRegionIndex( const std::vector<unsigned int> &index ) {
+      this->m_BufferedRegionIndex = index;
+      return *this;
+    }
+
+    std::vector<unsigned int> ImageFileReader::GetBufferedRegionIndex() const {
+      return this->m_BufferedRegionIndex;
+    }
+
+    ImageFileReader& ImageFileReader::SetBufferedRegionSize( const std::vector<unsigned int> &size ) {
+      this->m_BufferedRegionSize = size;
+      return *this;
+    }
+
+    std::vector<unsigned int> ImageFileReader::GetBufferedRegionSize() const {
+      return this->m_BufferedRegionSize;
+    }
+
+    ImageFileReader& ImageFileReader::SetUseMemoryMapping( bool useMemoryMapping ) {
+      this->m_UseMemoryMapping = useMemoryMapping;
+      return *this;
+    }
+
+    bool ImageFileReader::GetUseMemoryMapping( void ) const {
+      return this->m_UseMemoryMapping;
+    }
+
     Image ImageFileReader::Execute () {
 
       PixelIDValueType type = this->GetOutputPixelType();
@@ -119,6 +419,49 @@ namespace itk {
     reader->SetImageIO( imageio );
     reader->SetFileName( this->m_FileName.c_str() );
 
+    if ( this->m_UseMemoryMapping && this->m_BufferedRegionSize.empty() )
+      {
+      // The pixels can only be mapped if no conversion is needed
+      PixelIDValueType filePixelType;
+      unsigned int fileDimension;
+      this->GetPixelIDFromImageIO( imageio, filePixelType, fileDimension );
+      if ( filePixelType == ImageTypeToPixelIDValue<ImageType>::Result && fileDimension == ImageType::ImageDimension )
+        {
+        typename ImageType::Pointer image = MapImage<ImageType>( reader.GetPointer(), imageio, this->m_FileName );
+        if ( image.IsNotNull() )
+          {
+          return Image( image.GetPointer() );
+          }
+        }
+      }
+
+    if ( !this->m_BufferedRegionSize.empty() )
+      {
+      if ( this->m_BufferedRegionSize.size() != ImageType::ImageDimension
+           || ( !this->m_BufferedRegionIndex.empty() && this->m_BufferedRegionIndex.size() != ImageType::ImageDimension ) )
+        {
+        sitkExceptionMacro( "The BufferedRegionIndex and BufferedRegionSize must have the dimension of the image, "
+                            << ImageType::ImageDimension << "!" );
+        }
+
+      typename ImageType::RegionType region;
+      region.SetSize( sitkSTLVectorToITK<typename ImageType::SizeType>( this->m_BufferedRegionSize ) );
+      if ( !this->m_BufferedRegionIndex.empty() )
+        {
+        region.SetIndex( sitkSTLVectorToITK<typename ImageType::IndexType>( this->m_BufferedRegionIndex ) );
+        }
+
+      reader->UpdateOutputInformation();
+      if ( !reader->GetOutput()->GetLargestPossibleRegion().IsInside( region ) )
+        {
+        sitkExceptionMacro( "The buffered region " << region << " is outside of the image "
+                            << reader->GetOutput()->GetLargestPossibleRegion() << "!" );
+        }
+
+      // Only the requested region is read by ImageIOs which stream
+      reader->GetOutput()->SetRequestedRegion( region );
+      }
+
     this->PreUpdate( reader.GetPointer() );
 
     reader->Update();
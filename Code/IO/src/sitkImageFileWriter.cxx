@@ -19,6 +19,7 @@
 #include "sitkImageFileWriter.h"
 
 #include <itkImageIOBase.h>
+#include <itkImageIORegion.h>
 #include <itkImageFileWriter.h>
 #include <itkImageRegionIterator.h>
 #include <itkGDCMImageIO.h>
@@ -155,6 +156,17 @@ ImageFileWriter& ImageFileWriter::ExecuteInternal( const Image& inImage )
     writer->SetInput ( image );
     writer->SetImageIO( GetImageIOBase( this->m_FileName ).GetPointer() );
 
+    if ( image->GetBufferedRegion() != image->GetLargestPossibleRegion() )
+      {
+      // Only the buffered region is written, into the region of the
+      // file, if the ImageIO supports streamed writing
+      itk::ImageIORegion ioRegion( InputImageType::ImageDimension );
+      itk::ImageIORegionAdaptor< InputImageType::ImageDimension >::Convert( image->GetBufferedRegion(),
+                                                                             ioRegion,
+                                                                             image->GetLargestPossibleRegion().GetIndex() );
+      writer->SetIORegion( ioRegion );
+      }
+
     this->PreUpdate( writer.GetPointer() );
 
     writer->Update();
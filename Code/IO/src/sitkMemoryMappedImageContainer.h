@@ -0,0 +1,167 @@
+/*=========================================================================
+*
+*  Copyright Insight Software Consortium
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*         http://www.apache.org/licenses/LICENSE-2.0.txt
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*
+*=========================================================================*/
+#ifndef sitkMemoryMappedImageContainer_h
+#define sitkMemoryMappedImageContainer_h
+
+#include "sitkCommon.h"
+
+#include <itkImportImageContainer.h>
+
+#ifdef _WIN32
+#include "itkWindows.h"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <string>
+
+namespace itk {
+namespace simple {
+
+/** \class MemoryMappedImageContainer
+ * \brief A pixel container backed by a copy-on-write mapping of a file
+ *
+ * The pages of the file are shared through the operating system's
+ * page cache until they are written to. Writes to the pixels modify a
+ * private copy of the page and never reach the file. The mapping is
+ * released when the container is destroyed, so the lifetime of the
+ * mapping follows the images referencing the container.
+ */
+template< typename TElementIdentifier, typename TElement >
+class MemoryMappedImageContainer
+  : public ImportImageContainer< TElementIdentifier, TElement >
+{
+public:
+  typedef MemoryMappedImageContainer                          Self;
+  typedef ImportImageContainer< TElementIdentifier, TElement > Superclass;
+  typedef SmartPointer< Self >                                Pointer;
+  typedef SmartPointer< const Self >                          ConstPointer;
+
+  itkNewMacro( Self );
+  itkTypeMacro( MemoryMappedImageContainer, ImportImageContainer );
+
+  /** Map numberOfElements elements which start offset bytes into
+   * fileName. Returns false if the file could not be mapped. */
+  bool Map( const std::string &fileName, uint64_t offset, TElementIdentifier numberOfElements )
+    {
+      this->Unmap();
+
+      const uint64_t length = static_cast<uint64_t>( numberOfElements ) * sizeof( TElement );
+      if ( length == 0 )
+        {
+        return false;
+        }
+
+#ifdef _WIN32
+      SYSTEM_INFO systemInfo;
+      GetSystemInfo( &systemInfo );
+      const uint64_t alignedOffset = offset - offset % systemInfo.dwAllocationGranularity;
+
+      HANDLE file = CreateFileA( fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+      if ( file == INVALID_HANDLE_VALUE )
+        {
+        return false;
+        }
+
+      HANDLE fileMapping = CreateFileMappingA( file, NULL, PAGE_WRITECOPY, 0, 0, NULL );
+      CloseHandle( file );
+      if ( fileMapping == NULL )
+        {
+        return false;
+        }
+
+      // The view keeps the mapping alive after its handle is closed
+      this->m_MappingLength = static_cast<size_t>( length + offset - alignedOffset );
+      this->m_Mapping = MapViewOfFile( fileMapping, FILE_MAP_COPY,
+                                       static_cast<DWORD>( alignedOffset >> 32 ),
+                                       static_cast<DWORD>( alignedOffset & 0xFFFFFFFF ),
+                                       this->m_MappingLength );
+      CloseHandle( fileMapping );
+#else
+      const uint64_t pageSize = static_cast<uint64_t>( sysconf( _SC_PAGESIZE ) );
+      const uint64_t alignedOffset = offset - offset % pageSize;
+
+      const int file = open( fileName.c_str(), O_RDONLY );
+      if ( file == -1 )
+        {
+        return false;
+        }
+
+      // The mapping keeps the file open after its descriptor is closed
+      this->m_MappingLength = static_cast<size_t>( length + offset - alignedOffset );
+      this->m_Mapping = mmap( NULL, this->m_MappingLength, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, static_cast<off_t>( alignedOffset ) );
+      close( file );
+      if ( this->m_Mapping == MAP_FAILED )
+        {
+        this->m_Mapping = NULL;
+        }
+#endif
+
+      if ( this->m_Mapping == NULL )
+        {
+        this->m_MappingLength = 0;
+        return false;
+        }
+
+      TElement *buffer = reinterpret_cast<TElement *>( static_cast<char *>( this->m_Mapping ) + ( offset - alignedOffset ) );
+      this->SetImportPointer( buffer, numberOfElements, false );
+      return true;
+    }
+
+protected:
+  MemoryMappedImageContainer( void )
+    : m_Mapping( NULL ),
+      m_MappingLength( 0 )
+    {
+    }
+
+  virtual ~MemoryMappedImageContainer( void )
+    {
+      this->Unmap();
+    }
+
+private:
+  MemoryMappedImageContainer( const Self & ); // purposely not implemented
+  void operator=( const Self & );             // purposely not implemented
+
+  void Unmap( void )
+    {
+      if ( this->m_Mapping != NULL )
+        {
+        // Release the imported pointer before the memory goes away
+        this->Initialize();
+#ifdef _WIN32
+        UnmapViewOfFile( this->m_Mapping );
+#else
+        munmap( this->m_Mapping, this->m_MappingLength );
+#endif
+        this->m_Mapping = NULL;
+        this->m_MappingLength = 0;
+        }
+    }
+
+  void   *m_Mapping;
+  size_t  m_MappingLength;
+};
+
+}
+}
+
+#endif
@@ -1,4 +1,12 @@
-file( WRITE "${CMAKE_CURRENT_BINARY_DIR}/${proj}-build/CMakeCacheInit.txt" "${ep_common_cache}" )
+# Pixel types that elastix registers natively. Must match ElastixPixelIDTypeList
+# in Code/Common/include/sitkPixelIDTypeLists.h.
+set( ELASTIX_IMAGE_PIXELTYPES "float;short;unsigned short;unsigned char" )
+
+file( WRITE "${CMAKE_CURRENT_BINARY_DIR}/${proj}-build/CMakeCacheInit.txt" "${ep_common_cache}
+set( ELASTIX_IMAGE_2D_PIXELTYPES \"${ELASTIX_IMAGE_PIXELTYPES}\" CACHE STRING \"\" FORCE )
+set( ELASTIX_IMAGE_3D_PIXELTYPES \"${ELASTIX_IMAGE_PIXELTYPES}\" CACHE STRING \"\" FORCE )
+set( ELASTIX_IMAGE_4D_PIXELTYPES \"${ELASTIX_IMAGE_PIXELTYPES}\" CACHE STRING \"\" FORCE )
+" )
 
 set( ELASTIX_GIT_REPOSITORY ${git_protocol}://github.com/SuperElastix/elastix )
 set( ELASTIX_GIT_TAG ef057ff89233822b26b04b31c3c043af57d5deff )
@@ -21,9 +29,6 @@ ExternalProject_Add( Elastix
   -DBUILD_SHARED_LIBS:BOOL=${BUILD_SHARED_LIBS}
   -DCMAKE_INSTALL_PREFIX:PATH=<INSTALL_DIR>
   -DITK_DIR:PATH=${ITK_DIR}
-  -DELASTIX_IMAGE_2D_PIXELTYPES:STRING=float
-  -DELASTIX_IMAGE_3D_PIXELTYPES:STRING=float
-  -DELASTIX_IMAGE_4D_PIXELTYPES:STRING=float
   -DUSE_AdaptiveStochasticGradientDescent:BOOL=ON                                           
   -DUSE_AdvancedAffineTransformElastix:BOOL=ON
   -DUSE_AdvancedBSplineTransform:BOOL=ON                                           
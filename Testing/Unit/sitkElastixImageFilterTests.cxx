@@ -1,6 +1,8 @@
 #include "SimpleITKTestHarness.h"
 #include "sitkCastImageFilter.h"
+#include "sitkHashImageFilter.h"
 #include "sitkElastixImageFilter.h"
+#include "sitkTransformixImageFilter.h"
 #include "sitkImageFileReader.h"
 #include "sitkImageFileWriter.h"
 #include "sitkBinaryThresholdImageFilter.h"
@@ -69,6 +71,394 @@ TEST( ElastixImageFilter, Registration2D )
   EXPECT_FALSE( silxIsEmpty( resultImage ) );
 }
 
+TEST( ElastixImageFilter, MoveResultImage )
+{
+  Image fixedImage = Cast( ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceBorder20.png" ) ), sitkFloat32 );
+  Image movingImage = Cast( ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceShifted13x17y.png" ) ), sitkFloat32 );
+
+  ElastixImageFilter silx;
+  EXPECT_NO_THROW( silx.SetParameterMap( GetDefaultParameterMap( "translation" ) ) );
+  EXPECT_NO_THROW( silx.SetFixedImage( fixedImage ) );
+  EXPECT_NO_THROW( silx.SetMovingImage( movingImage ) );
+  EXPECT_NO_THROW( silx.Execute() );
+
+  // The buffer is handed over, not copied
+  const Image resultImage = silx.GetResultImage();
+  const float* buffer = resultImage.GetBufferAsFloat();
+  Image movedResultImage;
+  EXPECT_NO_THROW( movedResultImage = silx.MoveResultImage() );
+  EXPECT_EQ( static_cast< const Image& >( movedResultImage ).GetBufferAsFloat(), buffer );
+  EXPECT_THROW( silx.GetResultImage(), GenericException );
+}
+
+TEST( ElastixImageFilter, Commands )
+{
+  Image fixedImage = ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceBorder20.png" ) );
+  Image movingImage = ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceShifted13x17y.png" ) );
+  Image resultImage;
+
+  ElastixImageFilter silx;
+  EXPECT_EQ( silx.GetName(), "ElastixImageFilter" );
+  EXPECT_NO_THROW( silx.SetFixedImage( fixedImage ) );
+  EXPECT_NO_THROW( silx.SetMovingImage( movingImage ) );
+  EXPECT_NO_THROW( silx.SetParameterMap( GetDefaultParameterMap( "translation" ) ) );
+
+  ProgressUpdate progressCmd( silx );
+  silx.AddCommand( sitkProgressEvent, progressCmd );
+
+  CountCommand abortCmd( silx );
+  silx.AddCommand( sitkAbortEvent, abortCmd );
+
+  CountCommand deleteCmd( silx );
+  silx.AddCommand( sitkDeleteEvent, deleteCmd );
+
+  CountCommand endCmd( silx );
+  silx.AddCommand( sitkEndEvent, endCmd );
+
+  CountCommand startCmd( silx );
+  silx.AddCommand( sitkStartEvent, startCmd );
+
+  EXPECT_NO_THROW( resultImage = silx.Execute() );
+  EXPECT_FALSE( silxIsEmpty( resultImage ) );
+
+  EXPECT_EQ( 1.0f, silx.GetProgress() );
+  EXPECT_EQ( 1.0f, progressCmd.m_Progress );
+  EXPECT_EQ( 0, abortCmd.m_Count );
+  EXPECT_EQ( 1, deleteCmd.m_Count );
+  EXPECT_EQ( 1, endCmd.m_Count );
+  EXPECT_EQ( 1, startCmd.m_Count );
+}
+
+TEST( ElastixImageFilter, NumberOfThreads )
+{
+  Image fixedImage = ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceBorder20.png" ) );
+  Image movingImage = ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceShifted13x17y.png" ) );
+  Image resultImage;
+
+  const unsigned int globalDefaultNumberOfThreads = ProcessObject::GetGlobalDefaultNumberOfThreads();
+
+  ElastixImageFilter silx;
+  EXPECT_EQ( silx.GetNumberOfThreads(), globalDefaultNumberOfThreads );
+  EXPECT_NO_THROW( silx.SetNumberOfThreads( 1 ) );
+  EXPECT_EQ( silx.GetNumberOfThreads(), 1u );
+  EXPECT_NO_THROW( silx.SetFixedImage( fixedImage ) );
+  EXPECT_NO_THROW( silx.SetMovingImage( movingImage ) );
+  EXPECT_NO_THROW( silx.SetParameterMap( GetDefaultParameterMap( "translation" ) ) );
+  EXPECT_NO_THROW( resultImage = silx.Execute() );
+  EXPECT_FALSE( silxIsEmpty( resultImage ) );
+
+  // The thread budget only applies to the execution of this filter
+  EXPECT_EQ( ProcessObject::GetGlobalDefaultNumberOfThreads(), globalDefaultNumberOfThreads );
+}
+
+TEST( ElastixImageFilter, PixelTypes )
+{
+  Image fixedImage = ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceBorder20.png" ) );
+  Image movingImage = ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceShifted13x17y.png" ) );
+  Image resultImage;
+
+  ElastixImageFilter silx;
+  EXPECT_NO_THROW( silx.SetParameterMap( GetDefaultParameterMap( "translation" ) ) );
+
+  // By default all images are casted to float
+  EXPECT_FALSE( silx.GetUseNativePixelType() );
+  EXPECT_NO_THROW( silx.SetFixedImage( fixedImage ) );
+  EXPECT_NO_THROW( silx.SetMovingImage( movingImage ) );
+  EXPECT_NO_THROW( resultImage = silx.Execute() );
+  EXPECT_FALSE( silxIsEmpty( resultImage ) );
+  EXPECT_EQ( resultImage.GetPixelID(), sitkFloat32 );
+
+  // With native pixel types, images of the same supported pixel type are not casted
+  EXPECT_NO_THROW( silx.UseNativePixelTypeOn() );
+  EXPECT_TRUE( silx.GetUseNativePixelType() );
+  EXPECT_NO_THROW( silx.SetFixedImage( Cast( fixedImage, sitkInt16 ) ) );
+  EXPECT_NO_THROW( silx.SetMovingImage( Cast( movingImage, sitkInt16 ) ) );
+  EXPECT_NO_THROW( resultImage = silx.Execute() );
+  EXPECT_FALSE( silxIsEmpty( resultImage ) );
+  EXPECT_EQ( resultImage.GetPixelID(), sitkInt16 );
+
+  EXPECT_NO_THROW( silx.SetFixedImage( Cast( fixedImage, sitkUInt16 ) ) );
+  EXPECT_NO_THROW( silx.SetMovingImage( Cast( movingImage, sitkUInt16 ) ) );
+  EXPECT_NO_THROW( resultImage = silx.Execute() );
+  EXPECT_EQ( resultImage.GetPixelID(), sitkUInt16 );
+
+  // Other combinations are casted to float
+  EXPECT_NO_THROW( silx.SetFixedImage( Cast( fixedImage, sitkUInt8 ) ) );
+  EXPECT_NO_THROW( silx.SetMovingImage( Cast( movingImage, sitkInt16 ) ) );
+  EXPECT_NO_THROW( resultImage = silx.Execute() );
+  EXPECT_EQ( resultImage.GetPixelID(), sitkFloat32 );
+
+  EXPECT_NO_THROW( silx.SetFixedImage( Cast( fixedImage, sitkFloat64 ) ) );
+  EXPECT_NO_THROW( silx.SetMovingImage( Cast( movingImage, sitkFloat64 ) ) );
+  EXPECT_NO_THROW( resultImage = silx.Execute() );
+  EXPECT_EQ( resultImage.GetPixelID(), sitkFloat32 );
+}
+
+TEST( ElastixImageFilter, Cache )
+{
+  Image fixedImage = Cast( ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceBorder20.png" ) ), sitkFloat64 );
+  Image movingImage = Cast( ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceShifted13x17y.png" ) ), sitkFloat64 );
+  const uint64_t castFixedImageSize = fixedImage.GetNumberOfPixels() * sizeof( float );
+
+  ElastixImageFilter silx;
+  EXPECT_EQ( silx.GetCacheSize(), 0u );
+  EXPECT_NO_THROW( silx.SetParameterMap( GetDefaultParameterMap( "translation" ) ) );
+  EXPECT_NO_THROW( silx.SetFixedImage( fixedImage ) );
+  EXPECT_NO_THROW( silx.SetMovingImage( movingImage ) );
+
+  // Caching is disabled by default
+  EXPECT_EQ( silx.GetMaximumCacheSize(), 0u );
+  EXPECT_NO_THROW( silx.Execute() );
+  EXPECT_EQ( silx.GetCacheSize(), 0u );
+
+  // The casted fixed image is reused by the next execution
+  EXPECT_NO_THROW( silx.SetMaximumCacheSize( 1073741824 ) );
+  EXPECT_NO_THROW( silx.Execute() );
+  EXPECT_EQ( silx.GetCacheSize(), castFixedImageSize );
+  EXPECT_NO_THROW( silx.SetParameter( "MaximumNumberOfIterations", "8" ) );
+  EXPECT_NO_THROW( silx.Execute() );
+  EXPECT_EQ( silx.GetCacheSize(), castFixedImageSize );
+
+  EXPECT_NO_THROW( silx.ClearCache() );
+  EXPECT_EQ( silx.GetCacheSize(), 0u );
+
+  // Images larger than the maximum cache size are not cached
+  EXPECT_NO_THROW( silx.SetMaximumCacheSize( castFixedImageSize - 1 ) );
+  EXPECT_EQ( silx.GetMaximumCacheSize(), castFixedImageSize - 1 );
+  EXPECT_NO_THROW( silx.Execute() );
+  EXPECT_EQ( silx.GetCacheSize(), 0u );
+}
+
+TEST( ElastixImageFilter, RandomSeed )
+{
+  Image fixedImage = ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceBorder20.png" ) );
+  Image movingImage = ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceShifted13x17y.png" ) );
+
+  ElastixImageFilter silx;
+  EXPECT_FALSE( silx.HasRandomSeed() );
+  EXPECT_NO_THROW( silx.SetParameterMap( GetDefaultParameterMap( "affine" ) ) );
+  EXPECT_NO_THROW( silx.SetFixedImage( fixedImage ) );
+  EXPECT_NO_THROW( silx.SetMovingImage( movingImage ) );
+  EXPECT_NO_THROW( silx.SetRandomSeed( 42 ) );
+  EXPECT_EQ( silx.GetRandomSeed(), 42u );
+
+  // Identical seeds give identical results
+  Image resultImage;
+  EXPECT_NO_THROW( resultImage = silx.Execute() );
+  const std::string resultImageHash = Hash( resultImage );
+  const ElastixImageFilter::ParameterMapVectorType transformParameterMap = silx.GetTransformParameterMap();
+  EXPECT_NO_THROW( resultImage = silx.Execute() );
+  EXPECT_EQ( Hash( resultImage ), resultImageHash );
+  EXPECT_EQ( silx.GetTransformParameterMap()[ 0 ][ "TransformParameters" ], transformParameterMap[ 0 ][ "TransformParameters" ] );
+
+  // The seed is not stored in the parameter maps
+  EXPECT_EQ( silx.GetParameterMap()[ 0 ].count( "RandomSeed" ), 0u );
+
+  // A seed of 0 is passed on to elastix like any other, and gives the same
+  // result as a "RandomSeed" of 0 in the parameter map
+  EXPECT_NO_THROW( silx.SetRandomSeed( 0 ) );
+  EXPECT_TRUE( silx.HasRandomSeed() );
+  EXPECT_EQ( silx.GetRandomSeed(), 0u );
+  EXPECT_NO_THROW( resultImage = silx.Execute() );
+  const std::string zeroSeedResultImageHash = Hash( resultImage );
+
+  EXPECT_NO_THROW( silx.RemoveRandomSeed() );
+  EXPECT_FALSE( silx.HasRandomSeed() );
+  EXPECT_NO_THROW( silx.SetParameter( "RandomSeed", "0" ) );
+  EXPECT_NO_THROW( resultImage = silx.Execute() );
+  EXPECT_EQ( Hash( resultImage ), zeroSeedResultImageHash );
+}
+
+TEST( ElastixImageFilter, LowMemoryMode )
+{
+  Image fixedImage = Cast( ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceBorder20.png" ) ), sitkFloat64 );
+  Image movingImage = Cast( ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceShifted13x17y.png" ) ), sitkFloat64 );
+
+  ElastixImageFilter silx;
+  EXPECT_FALSE( silx.GetLowMemoryMode() );
+  EXPECT_EQ( silx.GetPeakMemoryUsage(), 0u );
+  EXPECT_NO_THROW( silx.SetParameterMap( GetDefaultParameterMap( "translation" ) ) );
+  EXPECT_NO_THROW( silx.SetFixedImage( fixedImage ) );
+  EXPECT_NO_THROW( silx.SetMovingImage( movingImage ) );
+  EXPECT_NO_THROW( silx.SetMaximumCacheSize( 1073741824 ) );
+  EXPECT_NO_THROW( silx.LowMemoryModeOn() );
+
+  // Casted fixed images are not cached and the parameter maps are not changed
+  EXPECT_NO_THROW( silx.Execute() );
+  EXPECT_EQ( silx.GetCacheSize(), 0u );
+  EXPECT_EQ( silx.GetParameterMap()[ 0 ].count( "ComputePyramidImagesPerResolution" ), 0u );
+  EXPECT_GT( silx.GetPeakMemoryUsage(), 0u );
+
+  // Groupwise registration of the same image
+  EXPECT_NO_THROW( silx.SetMovingImage( fixedImage ) );
+  EXPECT_NO_THROW( silx.Execute() );
+
+  // Images of a pixel type elastix is compiled with are not casted to float
+  Image resultImage;
+  EXPECT_FALSE( silx.GetUseNativePixelType() );
+  EXPECT_NO_THROW( silx.SetFixedImage( Cast( fixedImage, sitkUInt16 ) ) );
+  EXPECT_NO_THROW( silx.SetMovingImage( Cast( movingImage, sitkUInt16 ) ) );
+  EXPECT_NO_THROW( resultImage = silx.Execute() );
+  EXPECT_EQ( resultImage.GetPixelID(), sitkUInt16 );
+  EXPECT_EQ( silx.GetCacheSize(), 0u );
+}
+
+TEST( ElastixImageFilter, ExecuteAsync )
+{
+  Image fixedImage = Cast( ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceBorder20.png" ) ), sitkFloat32 );
+  Image movingImage = Cast( ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceShifted13x17y.png" ) ), sitkFloat32 );
+
+  ElastixImageFilter silx1;
+  silx1.SetParameterMap( GetDefaultParameterMap( "translation" ) );
+  silx1.SetFixedImage( fixedImage );
+  silx1.SetMovingImage( movingImage );
+
+  ElastixImageFilter silx2;
+  silx2.SetParameterMap( GetDefaultParameterMap( "translation" ) );
+  silx2.SetFixedImage( fixedImage );
+  silx2.SetMovingImage( movingImage );
+
+  // Several instances run at the same time
+  EXPECT_NO_THROW( silx1.ExecuteAsync() );
+  EXPECT_THROW( silx1.ExecuteAsync(), GenericException );
+  EXPECT_NO_THROW( silx2.ExecuteAsync() );
+
+  // The filter is not accessible until Wait() has returned
+  EXPECT_THROW( silx1.SetParameter( "Transform", "AffineTransform" ), GenericException );
+  EXPECT_THROW( silx1.GetParameterMap(), GenericException );
+  EXPECT_THROW( silx1.SetFixedImage( fixedImage ), GenericException );
+  EXPECT_THROW( silx1.Execute(), GenericException );
+
+  Image resultImage1;
+  Image resultImage2;
+  EXPECT_NO_THROW( resultImage1 = silx1.Wait() );
+  EXPECT_NO_THROW( resultImage2 = silx2.Wait() );
+  EXPECT_TRUE( silx1.IsDone() );
+  EXPECT_FALSE( silxIsEmpty( resultImage1 ) );
+  EXPECT_FALSE( silxIsEmpty( resultImage2 ) );
+  EXPECT_EQ( silx1.GetTransformParameterMap().size(), 1u );
+
+  // Errors and cancellation are reported by Wait()
+  EXPECT_NO_THROW( silx1.SetParameter( "Transform", "NoSuchTransform" ) );
+  EXPECT_NO_THROW( silx1.ExecuteAsync() );
+  EXPECT_THROW( silx1.Wait(), GenericException );
+
+  EXPECT_NO_THROW( silx2.ExecuteAsync() );
+  EXPECT_NO_THROW( silx2.Cancel() );
+  EXPECT_THROW( silx2.Wait(), GenericException );
+}
+
+TEST( ElastixImageFilter, IterationInfo )
+{
+  Image fixedImage = Cast( ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceBorder20.png" ) ), sitkFloat32 );
+  Image movingImage = Cast( ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceShifted13x17y.png" ) ), sitkFloat32 );
+
+  ElastixImageFilter silx;
+  EXPECT_FALSE( silx.GetRecordIterationInfo() );
+  EXPECT_NO_THROW( silx.SetParameterMap( GetDefaultParameterMap( "translation", 2 ) ) );
+  EXPECT_NO_THROW( silx.SetParameter( "MaximumNumberOfIterations", "16" ) );
+  EXPECT_NO_THROW( silx.SetFixedImage( fixedImage ) );
+  EXPECT_NO_THROW( silx.SetMovingImage( movingImage ) );
+  EXPECT_NO_THROW( silx.Execute() );
+  EXPECT_THROW( silx.GetIterationInfo(), GenericException );
+
+  // Read from a private temporary directory unless an output directory is set
+  EXPECT_NO_THROW( silx.RecordIterationInfoOn() );
+  EXPECT_NO_THROW( silx.Execute() );
+
+  std::map< std::string, std::vector< double > > iterationInfo = silx.GetIterationInfo();
+  ASSERT_TRUE( iterationInfo.count( "Metric" ) );
+  ASSERT_TRUE( iterationInfo.count( "Resolution" ) );
+  ASSERT_TRUE( iterationInfo.count( "ParameterMap" ) );
+  EXPECT_EQ( iterationInfo[ "Metric" ].size(), 32u );
+  EXPECT_EQ( iterationInfo[ "Resolution" ].size(), 32u );
+  EXPECT_EQ( iterationInfo[ "Resolution" ].front(), 0.0 );
+  EXPECT_EQ( iterationInfo[ "Resolution" ].back(), 1.0 );
+  EXPECT_EQ( iterationInfo[ "ParameterMap" ].back(), 0.0 );
+
+  // Tables of earlier runs in the output directory are not read
+  {
+  std::ofstream staleIterationInfo( ( dataFinder.GetOutputDirectory() + "/IterationInfo.0.R2.txt" ).c_str() );
+  staleIterationInfo << "1:ItNr\t2:Metric\n0\t1.0\n";
+  }
+  EXPECT_NO_THROW( silx.SetOutputDirectory( dataFinder.GetOutputDirectory() ) );
+  EXPECT_NO_THROW( silx.Execute() );
+  iterationInfo = silx.GetIterationInfo();
+  EXPECT_EQ( iterationInfo[ "Metric" ].size(), 32u );
+  EXPECT_EQ( iterationInfo[ "Resolution" ].back(), 1.0 );
+}
+
+TEST( ElastixImageFilter, ResultCache )
+{
+  Image fixedImage = Cast( ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceBorder20.png" ) ), sitkFloat32 );
+  Image movingImage = Cast( ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceShifted13x17y.png" ) ), sitkFloat32 );
+
+  ElastixImageFilter silx;
+  EXPECT_EQ( silx.GetMaximumNumberOfCachedResults(), 0u );
+  EXPECT_NO_THROW( silx.SetMaximumNumberOfCachedResults( 1 ) );
+  EXPECT_NO_THROW( silx.SetParameterMap( GetDefaultParameterMap( "translation" ) ) );
+  EXPECT_NO_THROW( silx.SetFixedImage( fixedImage ) );
+  EXPECT_NO_THROW( silx.SetMovingImage( movingImage ) );
+  EXPECT_NO_THROW( silx.RecordIterationInfoOn() );
+
+  Image resultImage1;
+  EXPECT_NO_THROW( resultImage1 = silx.Execute() );
+  EXPECT_EQ( silx.GetNumberOfCachedResults(), 1u );
+  EXPECT_NO_THROW( silx.GetIterationInfo() );
+  ElastixImageFilter::ParameterMapVectorType transformParameterMapVector = silx.GetTransformParameterMap();
+
+  // A cache hit does not run elastix, so there is no iteration info
+  Image resultImage2;
+  EXPECT_NO_THROW( resultImage2 = silx.Execute() );
+  EXPECT_THROW( silx.GetIterationInfo(), GenericException );
+  EXPECT_EQ( Hash( resultImage1 ), Hash( resultImage2 ) );
+  EXPECT_EQ( silx.GetTransformParameterMap(), transformParameterMapVector );
+
+  // Changed parameters miss the cache and replace the least recently used entry
+  EXPECT_NO_THROW( silx.SetParameter( "MaximumNumberOfIterations", "8" ) );
+  EXPECT_NO_THROW( silx.Execute() );
+  EXPECT_NO_THROW( silx.GetIterationInfo() );
+  EXPECT_EQ( silx.GetNumberOfCachedResults(), 1u );
+
+  EXPECT_NO_THROW( silx.ClearResultCache() );
+  EXPECT_EQ( silx.GetNumberOfCachedResults(), 0u );
+}
+
+TEST( ElastixImageFilter, CropToMasks )
+{
+  Image fixedImage = Cast( ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceBorder20.png" ) ), sitkFloat32 );
+  Image fixedMask = Cast( ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceBorder20Mask.png" ) ), sitkUInt8 );
+  Image movingImage = Cast( ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceShifted13x17y.png" ) ), sitkFloat32 );
+
+  ElastixImageFilter silx;
+  EXPECT_FALSE( silx.GetCropToMasks() );
+  EXPECT_EQ( silx.GetCropToMasksPadding(), 8u );
+  EXPECT_NO_THROW( silx.SetParameterMap( GetDefaultParameterMap( "translation" ) ) );
+  EXPECT_NO_THROW( silx.SetFixedImage( fixedImage ) );
+  EXPECT_NO_THROW( silx.SetFixedMask( fixedMask ) );
+  EXPECT_NO_THROW( silx.SetMovingImage( movingImage ) );
+  EXPECT_NO_THROW( silx.CropToMasksOn() );
+  EXPECT_NO_THROW( silx.SetCropToMasksPadding( 4 ) );
+
+  // The result image and the transform parameter maps refer to the full fixed image
+  Image resultImage;
+  EXPECT_NO_THROW( resultImage = silx.Execute() );
+  EXPECT_EQ( resultImage.GetSize(), fixedImage.GetSize() );
+  EXPECT_EQ( resultImage.GetOrigin(), fixedImage.GetOrigin() );
+  ElastixImageFilter::ParameterMapType transformParameterMap = silx.GetTransformParameterMap( 0 );
+  EXPECT_EQ( transformParameterMap[ "Index" ], ElastixImageFilter::ParameterValueVectorType( 2, "0" ) );
+
+  TransformixImageFilter stfx;
+  stfx.SetMovingImage( movingImage );
+  stfx.SetTransformParameterMap( silx.GetTransformParameterMap() );
+  EXPECT_NO_THROW( resultImage = stfx.Execute() );
+  EXPECT_EQ( resultImage.GetSize(), fixedImage.GetSize() );
+
+  // A B-spline control point grid would only cover the cropped region
+  EXPECT_NO_THROW( silx.SetParameterMap( GetDefaultParameterMap( "bspline" ) ) );
+  EXPECT_THROW( silx.Execute(), GenericException );
+}
+
 TEST( ElastixImageFilter, Masks )
 {
   Image fixedImage = ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceBorder20.png" ) );
@@ -87,7 +477,13 @@ TEST( ElastixImageFilter, Masks )
   EXPECT_NO_THROW( resultImage = silx.Execute() );
   EXPECT_FALSE( silxIsEmpty( resultImage ) );
 
-  // Only accept masks of pixel type unsigned char
+  // Accept masks of any integer pixel type
+  EXPECT_NO_THROW( silx.SetMovingMask( Cast( movingMask, sitkUInt16 ) ) );
+  EXPECT_NO_THROW( silx.Execute() );
+  EXPECT_NO_THROW( silx.SetMovingMask( Cast( movingMask, sitkInt32 ) ) );
+  EXPECT_NO_THROW( silx.Execute() );
+
+  // Only accept masks of integer pixel types
   EXPECT_NO_THROW( silx.SetMovingMask( movingMaskInvalidType ) );
   EXPECT_THROW( silx.Execute(), GenericException );
   EXPECT_NO_THROW( silx.SetMovingMask( movingMask ) );
@@ -359,6 +755,62 @@ TEST( ElastixImageFilter, InitialTransform )
   EXPECT_FALSE( silxIsEmpty( resultImage2 ) );
 }
 
+TEST( ElastixImageFilter, TransformParameterMapToTransform )
+{
+  ElastixImageFilter::ParameterMapType translationParameterMap;
+  translationParameterMap[ "Transform" ] = ElastixImageFilter::ParameterValueVectorType( 1, "TranslationTransform" );
+  translationParameterMap[ "FixedImageDimension" ] = ElastixImageFilter::ParameterValueVectorType( 1, "2" );
+  translationParameterMap[ "TransformParameters" ].push_back( "13.0" );
+  translationParameterMap[ "TransformParameters" ].push_back( "17.0" );
+
+  std::vector< double > point( 2, 0.0 );
+  Transform translationTransform = TransformParameterMapToTransform( translationParameterMap );
+  EXPECT_EQ( translationTransform.GetDimension(), 2u );
+  EXPECT_NEAR( translationTransform.TransformPoint( point )[ 0 ], 13.0, 1e-9 );
+  EXPECT_NEAR( translationTransform.TransformPoint( point )[ 1 ], 17.0, 1e-9 );
+
+  // Chained maps are composed in elastix order
+  ElastixImageFilter::ParameterMapVectorType translationParameterMaps( 2, translationParameterMap );
+  EXPECT_NEAR( TransformParameterMapToTransform( translationParameterMaps ).TransformPoint( point )[ 0 ], 26.0, 1e-9 );
+  translationParameterMaps[ 1 ][ "HowToCombineTransforms" ] = ElastixImageFilter::ParameterValueVectorType( 1, "Add" );
+  EXPECT_THROW( TransformParameterMapToTransform( translationParameterMaps ), GenericException );
+
+  ElastixImageFilter::ParameterMapType unsupportedParameterMap = translationParameterMap;
+  unsupportedParameterMap[ "Transform" ] = ElastixImageFilter::ParameterValueVectorType( 1, "SplineKernelTransform" );
+  EXPECT_THROW( TransformParameterMapToTransform( unsupportedParameterMap ), GenericException );
+  EXPECT_THROW( TransformParameterMapToTransform( ElastixImageFilter::ParameterMapVectorType() ), GenericException );
+
+  // Registered transforms map points like transformix does
+  Image fixedImage = ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceBorder20.png" ) );
+  Image movingImage = ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceShifted13x17y.png" ) );
+
+  ElastixImageFilter silx;
+  silx.SetFixedImage( fixedImage );
+  silx.SetMovingImage( movingImage );
+  silx.SetParameterMap( "rigid" );
+  silx.AddParameterMap( silx.GetDefaultParameterMap( "affine" ) );
+  silx.AddParameterMap( silx.GetDefaultParameterMap( "bspline" ) );
+  silx.SetParameter( "MaximumNumberOfIterations", "16" );
+  silx.Execute();
+
+  Transform transform;
+  EXPECT_NO_THROW( transform = silx.GetTransform() );
+
+  std::vector< double > fixedPointSet;
+  fixedPointSet.push_back( 100.0 );
+  fixedPointSet.push_back( 110.0 );
+
+  TransformixImageFilter stfx;
+  stfx.SetTransformParameterMap( silx.GetTransformParameterMap() );
+  stfx.SetFixedPointSet( fixedPointSet );
+  stfx.Execute();
+
+  const std::vector< double > transformixPoint = stfx.GetResultPointSet();
+  const std::vector< double > transformPoint = transform.TransformPoint( fixedPointSet );
+  EXPECT_NEAR( transformPoint[ 0 ], transformixPoint[ 0 ], 1e-3 );
+  EXPECT_NEAR( transformPoint[ 1 ], transformixPoint[ 1 ], 1e-3 );
+}
+
 TEST( ElastixImageFilter, InverseTransform )
 {
   Image fixedImage = ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceBorder20.png" ) );
@@ -374,6 +826,12 @@ TEST( ElastixImageFilter, InverseTransform )
   EXPECT_THROW( inverseParameterMapVector = silx.GetInverseTransformParameterMap(), GenericException );
   EXPECT_NO_THROW( silx.ExecuteInverse() );
   EXPECT_NO_THROW( inverseParameterMapVector = silx.GetInverseTransformParameterMap() );
+
+  // The forward transform is not chained through the output directory
+  EXPECT_NO_THROW( silx.SetOutputDirectory( dataFinder.GetOutputFile( "NonExistingDirectory" ) ) );
+  EXPECT_NO_THROW( silx.ExecuteInverse() );
+  EXPECT_NO_THROW( inverseParameterMapVector = silx.GetInverseTransformParameterMap() );
+  EXPECT_EQ( inverseParameterMapVector[ 0 ][ "InitialTransformParametersFileName" ][ 0 ], "NoInitialTransform" );
 }
 
 TEST( ElastixImageFilter, SameFixedImageForMultipleRegistrations )
@@ -394,6 +852,49 @@ TEST( ElastixImageFilter, SameFixedImageForMultipleRegistrations )
   EXPECT_FALSE( silxIsEmpty( resultImage2 ) );
 }
 
+TEST( ElastixImageFilter, ExecuteBatch )
+{
+  Image fixedImage = ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceBorder20.png" ) );
+  Image movingImage = ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceShifted13x17y.png" ) );
+
+  ElastixImageFilter::VectorOfImage movingImages;
+  movingImages.push_back( movingImage );
+  movingImages.push_back( Cast( movingImage, sitkFloat32 ) );
+
+  ElastixImageFilter silx;
+  silx.SetParameterMap( "translation" );
+  EXPECT_THROW( silx.GetBatchTransformParameterMap(), GenericException );
+  EXPECT_THROW( silx.ExecuteBatch( fixedImage, ElastixImageFilter::VectorOfImage() ), GenericException );
+  EXPECT_THROW( silx.ExecuteBatch( Image(), movingImages ), GenericException );
+
+  ElastixImageFilter::VectorOfImage resultImages;
+  EXPECT_NO_THROW( resultImages = silx.ExecuteBatch( fixedImage, movingImages ) );
+  ASSERT_EQ( resultImages.size(), 2u );
+  EXPECT_FALSE( silxIsEmpty( resultImages[ 0 ] ) );
+  EXPECT_FALSE( silxIsEmpty( resultImages[ 1 ] ) );
+  EXPECT_EQ( silx.GetBatchTransformParameterMap().size(), 2u );
+  EXPECT_EQ( silx.GetBatchTransformParameterMap()[ 1 ], silx.GetTransformParameterMap() );
+
+  // Inputs of the filter are left as they were
+  EXPECT_EQ( silx.GetNumberOfFixedImages(), 0u );
+  EXPECT_EQ( silx.GetNumberOfMovingImages(), 0u );
+
+  // The shared fixed image cast and mask give the results of separate registrations
+  Image fixedMask = Cast( ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceBorder20Mask.png" ) ), sitkUInt16 );
+  EXPECT_NO_THROW( silx.SetFixedMask( fixedMask ) );
+  EXPECT_NO_THROW( silx.SetRandomSeed( 42 ) );
+  EXPECT_NO_THROW( resultImages = silx.ExecuteBatch( fixedImage, movingImages ) );
+  ASSERT_EQ( resultImages.size(), 2u );
+  EXPECT_EQ( silx.GetFixedMask( 0 ).GetPixelID(), sitkUInt16 );
+
+  EXPECT_NO_THROW( silx.SetFixedImage( fixedImage ) );
+  for( unsigned int i = 0; i < movingImages.size(); ++i )
+  {
+    EXPECT_NO_THROW( silx.SetMovingImage( movingImages[ i ] ) );
+    EXPECT_EQ( Hash( silx.Execute() ), Hash( resultImages[ i ] ) );
+  }
+}
+
 TEST( ElastixImageFilter, Registration3D )
 {
   Image fixedImage = ReadImage( dataFinder.GetFile( "Input/OAS1_0001_MR1_mpr-1_anon.nrrd" ) );
@@ -22,6 +22,9 @@
 #include <sitkImageSeriesWriter.h>
 #include <sitkHashImageFilter.h>
 #include <sitkPhysicalPointImageSource.h>
+#include <sitkAddImageFilter.h>
+
+#include <fstream>
 
 TEST(IO,ImageFileReader) {
 
@@ -139,6 +142,121 @@ TEST(IO,ImageFileWriter) {
   EXPECT_NO_THROW ( writer.ToString() );
 }
 
+TEST(IO,StreamedReadWrite) {
+  namespace sitk = itk::simple;
+
+  sitk::Image img = sitk::Image( 10, 10, 10, sitk::sitkUInt16 );
+  std::vector<uint32_t> idx( 3, 0 );
+  for ( idx[2] = 0; idx[2] < 10; ++idx[2] )
+    {
+    img.SetPixelAsUInt16( idx, idx[2] );
+    }
+
+  const std::string filename = dataFinder.GetOutputFile ( "IO.StreamedReadWrite.mha" );
+  const std::string outputFilename = dataFinder.GetOutputFile ( "IO.StreamedReadWrite.Output.mha" );
+  sitk::WriteImage( img, filename );
+  sitk::WriteImage( sitk::Image( 10, 10, 10, sitk::sitkUInt16 ), outputFilename );
+
+  sitk::ImageFileReader reader;
+  reader.SetFileName( filename );
+
+  sitk::ImageFileWriter writer;
+  writer.SetFileName( outputFilename );
+
+  std::vector<unsigned int> bufferedIndex( 3, 0 );
+  std::vector<unsigned int> bufferedSize( 3, 10 );
+  bufferedSize[2] = 5;
+  for ( bufferedIndex[2] = 0; bufferedIndex[2] < 10; bufferedIndex[2] += 5 )
+    {
+    sitk::Image slab = reader.SetBufferedRegionIndex( bufferedIndex ).SetBufferedRegionSize( bufferedSize ).Execute();
+    EXPECT_EQ( img.GetSize(), slab.GetSize() );
+    EXPECT_EQ( bufferedIndex, slab.GetBufferedIndex() );
+    EXPECT_EQ( bufferedSize, slab.GetBufferedSize() );
+
+    idx[2] = bufferedIndex[2] + 2;
+    EXPECT_EQ( idx[2], slab.GetPixelAsUInt16( idx ) );
+    idx[2] = ( bufferedIndex[2] + 5 ) % 10;
+    EXPECT_THROW( slab.GetPixelAsUInt16( idx ), sitk::GenericException );
+
+    sitk::Image result = sitk::Add( slab, 1.0 );
+    EXPECT_EQ( slab.GetBufferedIndex(), result.GetBufferedIndex() );
+    EXPECT_EQ( slab.GetBufferedSize(), result.GetBufferedSize() );
+    EXPECT_NO_THROW( writer.Execute( result ) );
+    }
+
+  EXPECT_EQ( sitk::Hash( sitk::Add( img, 1.0 ) ), sitk::Hash( sitk::ReadImage( outputFilename ) ) );
+}
+
+TEST(IO,MemoryMappedRead) {
+  namespace sitk = itk::simple;
+
+  sitk::Image img = sitk::Image( 10, 10, 10, sitk::sitkUInt8 );
+  std::vector<uint32_t> idx( 3, 0 );
+  idx[0] = 1;
+  idx[1] = 2;
+  idx[2] = 3;
+  img.SetPixelAsUInt8( idx, 42 );
+
+  const std::string filename = dataFinder.GetOutputFile ( "IO.MemoryMappedRead.mha" );
+  sitk::WriteImage( img, filename );
+
+  sitk::ImageFileReader reader;
+  EXPECT_FALSE( reader.GetUseMemoryMapping() );
+  reader.SetFileName( filename ).UseMemoryMappingOn();
+  EXPECT_TRUE( reader.GetUseMemoryMapping() );
+
+  sitk::Image mapped = reader.Execute();
+  EXPECT_EQ( img.GetSize(), mapped.GetSize() );
+  EXPECT_EQ( sitk::Hash( img ), sitk::Hash( mapped ) );
+
+  // modifying a mapped image does not change the file
+  mapped.SetPixelAsUInt8( idx, 7 );
+  EXPECT_EQ( 7, mapped.GetPixelAsUInt8( idx ) );
+  EXPECT_EQ( 42, reader.Execute().GetPixelAsUInt8( idx ) );
+
+  // compressed files are read as usual
+  const std::string compressedFilename = dataFinder.GetOutputFile ( "IO.MemoryMappedRead.Compressed.mha" );
+  sitk::WriteImage( img, compressedFilename, true );
+  EXPECT_EQ( sitk::Hash( img ), sitk::Hash( reader.SetFileName( compressedFilename ).Execute() ) );
+
+  // NRRD with attached raw data
+  const std::string nrrdFilename = dataFinder.GetOutputFile ( "IO.MemoryMappedRead.nrrd" );
+  sitk::WriteImage( img, nrrdFilename );
+  EXPECT_EQ( sitk::Hash( img ), sitk::Hash( reader.SetFileName( nrrdFilename ).Execute() ) );
+
+  // vector images, whose components are written fastest
+  sitk::Image vectorImg = sitk::Image( std::vector<unsigned int>( 3, 5 ), sitk::sitkVectorFloat32, 3 );
+  std::vector<float> v( 3 );
+  v[0] = 1.0f; v[1] = 2.0f; v[2] = 3.0f;
+  vectorImg.SetPixelAsVectorFloat32( std::vector<uint32_t>( 3, 2 ), v );
+  const std::string vectorFilename = dataFinder.GetOutputFile ( "IO.MemoryMappedRead.Vector.nrrd" );
+  sitk::WriteImage( vectorImg, vectorFilename );
+  sitk::Image mappedVector = reader.SetFileName( vectorFilename ).Execute();
+  EXPECT_EQ( 3u, mappedVector.GetNumberOfComponentsPerPixel() );
+  EXPECT_EQ( sitk::Hash( vectorImg ), sitk::Hash( mappedVector ) );
+
+  // a NRRD whose component axis is last is reordered by the reader, so
+  // it must not be mapped in file order
+  const std::string slowComponentsFilename = dataFinder.GetOutputFile ( "IO.MemoryMappedRead.SlowComponents.nrrd" );
+  {
+  std::ofstream nrrd( slowComponentsFilename.c_str(), std::ios::out | std::ios::binary );
+  nrrd << "NRRD0004\ntype: uint8\ndimension: 3\nsizes: 3 2 2\nkinds: domain domain vector\nencoding: raw\n\n";
+  for ( char i = 0; i < 12; ++i )
+    {
+    nrrd.put( i );
+    }
+  }
+  sitk::Image slowComponents = reader.SetFileName( slowComponentsFilename ).Execute();
+  EXPECT_EQ( 2u, slowComponents.GetNumberOfComponentsPerPixel() );
+  EXPECT_EQ( 0, slowComponents.GetPixelAsVectorUInt8( std::vector<uint32_t>( 2, 0 ) )[0] );
+  EXPECT_EQ( 6, slowComponents.GetPixelAsVectorUInt8( std::vector<uint32_t>( 2, 0 ) )[1] );
+  std::vector<uint32_t> pixel( 2, 0 );
+  pixel[0] = 1;
+  EXPECT_EQ( 1, slowComponents.GetPixelAsVectorUInt8( pixel )[0] );
+  EXPECT_EQ( 7, slowComponents.GetPixelAsVectorUInt8( pixel )[1] );
+  EXPECT_EQ( sitk::Hash( slowComponents ), sitk::Hash( reader.UseMemoryMappingOff().Execute() ) );
+}
+
 TEST(IO,ReadWrite) {
   namespace sitk = itk::simple;
   sitk::HashImageFilter hasher;
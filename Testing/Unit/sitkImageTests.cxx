@@ -31,6 +31,7 @@
 #include "sitkComplexToImaginaryImageFilter.h"
 #include "sitkRealAndImaginaryToComplexImageFilter.h"
 #include "sitkImportImageFilter.h"
+#include "sitkImageBufferAllocator.h"
 
 #include <itkIntTypes.h>
 
@@ -279,6 +280,19 @@ TEST_F(Image,Constructors) {
   EXPECT_EQ ( image.GetDimension(), 3u );
   EXPECT_EQ ( 10u, image.GetNumberOfComponentsPerPixel() );
 
+  // Uninitialized buffers are allocated, but their values are undefined
+  image = itk::simple::Image( s3d, itk::simple::sitkFloat32, 0, itk::simple::sitkUninitialized );
+  EXPECT_EQ ( image.GetDimension(), 3u );
+  EXPECT_EQ ( 125u, image.GetNumberOfPixels() );
+  EXPECT_TRUE ( image.GetBufferAsFloat() != NULL );
+  image = itk::simple::Image( s2d, itk::simple::sitkVectorFloat32, 4, itk::simple::sitkUninitialized );
+  EXPECT_EQ ( 4u, image.GetNumberOfComponentsPerPixel() );
+  image.SetPixelAsVectorFloat32( std::vector<unsigned int>( 2, 9 ), std::vector<float>( 4, 1.0f ) );
+  EXPECT_EQ ( 1.0f, image.GetPixelAsVectorFloat32( std::vector<unsigned int>( 2, 9 ) )[3] );
+
+  image = itk::simple::Image( s3d, itk::simple::sitkVectorFloat64, 2, itk::simple::sitkZeroInitialized );
+  EXPECT_EQ ( 0.0, image.GetPixelAsVectorFloat64( std::vector<unsigned int>( 3, 4 ) )[1] );
+
 
   // check for error when incorrect number of dimensions are requested
   std::vector<unsigned int> s1d(1, 100);
@@ -1574,6 +1588,152 @@ TEST_F(Image, GetBufferVector)
 
 }
 
+TEST_F(Image, GetSetRegion)
+{
+  sitk::Image img = sitk::Image( 10, 10, 10, sitk::sitkFloat32 );
+
+  std::vector<uint32_t> idx( 3, 0 );
+  for ( idx[2] = 0; idx[2] < 10; ++idx[2] )
+    {
+    for ( idx[1] = 0; idx[1] < 10; ++idx[1] )
+      {
+      for ( idx[0] = 0; idx[0] < 10; ++idx[0] )
+        {
+        img.SetPixelAsFloat( idx, idx[0] + 10*idx[1] + 100*idx[2] );
+        }
+      }
+    }
+
+  std::vector<uint32_t> index( 3 );
+  index[0] = 2; index[1] = 3; index[2] = 4;
+  std::vector<uint32_t> size( 3 );
+  size[0] = 3; size[1] = 2; size[2] = 2;
+
+  std::vector<float> region( 12 );
+  EXPECT_NO_THROW( img.GetRegionAsFloat( index, size, &region[0] ) );
+  EXPECT_EQ( 432.0f, region[0] ) << " First pixel of region";
+  EXPECT_EQ( 434.0f, region[2] ) << " Last pixel of first line";
+  EXPECT_EQ( 442.0f, region[3] ) << " First pixel of second line";
+  EXPECT_EQ( 544.0f, region[11] ) << " Last pixel of region";
+  ASSERT_ANY_THROW( img.GetRegionAsDouble( index, size, SITK_NULLPTR ) ) << " Get with wrong type";
+
+  for ( unsigned int i = 0; i < region.size(); ++i )
+    {
+    region[i] = -1.0f * i;
+    }
+  EXPECT_NO_THROW( img.SetRegionAsFloat( index, size, &region[0] ) );
+  idx[0] = 4; idx[1] = 4; idx[2] = 5;
+  EXPECT_EQ( -11.0f, img.GetPixelAsFloat( idx ) ) << " Last pixel of region";
+  idx[0] = 5;
+  EXPECT_EQ( 545.0f, img.GetPixelAsFloat( idx ) ) << " Pixel outside of region";
+
+  size[0] = 9;
+  ASSERT_ANY_THROW( img.GetRegionAsFloat( index, size, &region[0] ) ) << " Region outside of image";
+  ASSERT_ANY_THROW( img.GetRegionAsFloat( std::vector<uint32_t>( 2, 0 ), size, &region[0] ) ) << " Too short index";
+
+  sitk::Image vectorImg = sitk::Image( std::vector<unsigned int>( 2, 4 ), sitk::sitkVectorUInt8, 3 );
+  std::vector<uint8_t> vectorRegion( 2*2*3, 7 );
+  EXPECT_NO_THROW( vectorImg.SetRegionAsUInt8( std::vector<uint32_t>( 2, 1 ), std::vector<uint32_t>( 2, 2 ), &vectorRegion[0] ) );
+  EXPECT_EQ( 7, vectorImg.GetPixelAsVectorUInt8( std::vector<uint32_t>( 2, 2 ) )[2] );
+  EXPECT_EQ( 0, vectorImg.GetPixelAsVectorUInt8( std::vector<uint32_t>( 2, 3 ) )[0] );
+}
+
+namespace
+{
+// Counts the buffers obtained through it from the default allocator
+class CountingImageBufferAllocator
+  : public sitk::ImageBufferAllocator
+{
+public:
+  CountingImageBufferAllocator() : m_NumberOfAllocations(0), m_NumberOfBuffers(0) {}
+
+  virtual void *Allocate( size_t size, bool zeroInitialize )
+    {
+      ++m_NumberOfAllocations;
+      ++m_NumberOfBuffers;
+      return GetDefaultAllocator()->Allocate( size, zeroInitialize );
+    }
+  virtual void Deallocate( void *buffer, size_t size )
+    {
+      --m_NumberOfBuffers;
+      GetDefaultAllocator()->Deallocate( buffer, size );
+    }
+
+  unsigned int m_NumberOfAllocations;
+  int          m_NumberOfBuffers;
+};
+}
+
+TEST_F(Image, BufferAllocator)
+{
+  CountingImageBufferAllocator counter;
+  sitk::ImageBufferAllocator::SetThreadAllocator( &counter );
+  EXPECT_EQ( &counter, sitk::ImageBufferAllocator::GetAllocator() );
+
+  {
+  sitk::Image img1( 10, 10, 10, sitk::sitkFloat32 );
+  EXPECT_EQ( 1u, counter.m_NumberOfAllocations );
+  EXPECT_EQ( 0.0f, img1.GetPixelAsFloat( std::vector<uint32_t>( 3, 5 ) ) );
+
+  sitk::Image img2 = sitk::Add( img1, img1 );
+  EXPECT_LE( 2u, counter.m_NumberOfAllocations ) << " Filter output from the allocator";
+  EXPECT_EQ( 2, counter.m_NumberOfBuffers );
+  }
+  EXPECT_EQ( 0, counter.m_NumberOfBuffers ) << " Buffers returned to the allocator";
+
+  sitk::ImageBufferPool pool( 1024*1024, &counter );
+  sitk::ImageBufferAllocator::SetThreadAllocator( &pool );
+  const unsigned int numberOfAllocations = counter.m_NumberOfAllocations;
+  for ( unsigned int i = 0; i < 3; ++i )
+    {
+    sitk::Image img( 64, 64, sitk::sitkUInt16 );
+    img.SetPixelAsUInt16( std::vector<uint32_t>( 2, 0 ), 7 );
+    }
+  EXPECT_EQ( numberOfAllocations + 1, counter.m_NumberOfAllocations ) << " Pooled buffer reused";
+  EXPECT_EQ( sitk::ImageBufferPool::GetBucketSize( 64*64*2 ), pool.GetCachedSize() );
+  {
+  sitk::Image img( 64, 64, sitk::sitkUInt16 );
+  EXPECT_EQ( 0u, img.GetPixelAsUInt16( std::vector<uint32_t>( 2, 0 ) ) ) << " Reused buffer is zeroed";
+  EXPECT_EQ( 0u, pool.GetCachedSize() );
+  }
+
+  sitk::ImageBufferAllocator::SetThreadAllocator( SITK_NULLPTR );
+  pool.ReleaseCachedBuffers();
+  EXPECT_EQ( 0, counter.m_NumberOfBuffers );
+  EXPECT_EQ( sitk::ImageBufferAllocator::GetDefaultAllocator(), sitk::ImageBufferAllocator::GetAllocator() );
+
+  EXPECT_EQ( 64u, sitk::ImageBufferPool::GetBucketSize( 1 ) );
+  EXPECT_EQ( 4096u, sitk::ImageBufferPool::GetBucketSize( 4000 ) );
+  EXPECT_EQ( 5120u, sitk::ImageBufferPool::GetBucketSize( 4097 ) );
+
+  sitk::AlignedImageBufferAllocator aligned;
+  sitk::ImageBufferAllocator::SetThreadAllocator( &aligned );
+  {
+  sitk::Image img( 128, 128, 128, sitk::sitkUInt8 );
+  EXPECT_EQ( 0u, reinterpret_cast<size_t>( img.GetBufferAsUInt8() ) % sitk::AlignedImageBufferAllocator::HugePageAlignment );
+  EXPECT_EQ( 0u, img.GetPixelAsUInt8( std::vector<uint32_t>( 3, 127 ) ) );
+  }
+  sitk::ImageBufferAllocator::SetThreadAllocator( SITK_NULLPTR );
+  ASSERT_ANY_THROW( sitk::AlignedImageBufferAllocator( 3 ) );
+
+  // Empty images do not allocate from any of the allocators
+  sitk::ImageBufferAllocator *allocators[] = { sitk::ImageBufferAllocator::GetDefaultAllocator(), &counter, &pool, &aligned };
+  const unsigned int countedAllocations = counter.m_NumberOfAllocations;
+  for ( unsigned int i = 0; i < 4; ++i )
+    {
+    sitk::ImageBufferAllocator::SetThreadAllocator( allocators[i] );
+    EXPECT_NO_THROW( sitk::Image() ) << " Empty image with allocator " << i;
+    sitk::Image img;
+    EXPECT_EQ( 0u, img.GetNumberOfPixels() );
+    img = sitk::Image( 4, 4, sitk::sitkFloat32 );
+    EXPECT_EQ( 16u, img.GetNumberOfPixels() );
+    }
+  sitk::ImageBufferAllocator::SetThreadAllocator( SITK_NULLPTR );
+  pool.ReleaseCachedBuffers();
+  EXPECT_EQ( countedAllocations + 2, counter.m_NumberOfAllocations ) << " Only the non-empty images allocated";
+  EXPECT_EQ( 0, counter.m_NumberOfBuffers );
+}
+
 TEST_F(Image,MetaDataDictionary)
 {
   sitk::Image img = sitk::Image( 10,10, 10, sitk::sitkFloat32 );
@@ -126,6 +126,24 @@ class TestNumpySimpleITKInterface(unittest.TestCase):
         self.assertEqual(h, sitk.Hash(img2))
 
 
+    def test_image_region(self):
+        """Test reading and writing a region of an image with numpy"""
+
+        img = sitk.PhysicalPointSource(sitk.sitkVectorFloat32, [6,5,4])
+
+        nda = sitk.GetArrayViewFromImageRegion(img, [1,2,3], [3,2,1])
+        self.assertEqual(nda.shape, (1,2,3,3))
+        self.assertEqual(nda[0,0,0].tolist(), [1,2,3])
+        self.assertEqual(nda[0,1,2].tolist(), [3,3,3])
+
+        self.assertRaises(IndexError, sitk.GetArrayViewFromImageRegion, img, [4,0,0], [3,1,1])
+
+        img = sitk.Image([6,5,4], sitk.sitkUInt16)
+        sitk.SetImageRegionFromArray(img, np.full((1,2,3), 7), [1,2,3])
+        self.assertEqual(img[3,3,3], 7)
+        self.assertEqual(img[4,3,3], 0)
+        self.assertEqual(sitk.GetArrayViewFromImageRegion(img, [1,2,3], [3,2,1]).tolist(), [[[7]*3]*2])
+
     def test_legacy(self):
       """Test SimpleITK Image to numpy array."""
 
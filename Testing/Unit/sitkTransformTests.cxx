@@ -35,6 +35,7 @@
 #include "sitkAdditionalProcedures.h"
 #include "sitkResampleImageFilter.h"
 #include "sitkHashImageFilter.h"
+#include "sitkImageBufferAllocator.h"
 
 
 #include "itkMath.h"
@@ -890,6 +891,35 @@ TEST(TransformTest,DisplacementFieldTransform_Points)
 
 }
 
+TEST(TransformTest,DisplacementFieldTransform_BufferAllocator)
+{
+  const std::vector<unsigned int> idx(2,0u);
+  sitk::AlignedImageBufferAllocator aligned;
+
+  // The buffer is handed to the transform when both images release it
+  // to the same allocator
+  sitk::ImageBufferAllocator::SetThreadAllocator( &aligned );
+  sitk::Image disImage( std::vector<unsigned int>(2,5u), sitk::sitkVectorFloat64 );
+  disImage.SetPixelAsVectorFloat64( idx, v2(0.5,0.5) );
+  {
+  sitk::DisplacementFieldTransform tx(disImage);
+  EXPECT_VECTOR_DOUBLE_NEAR( tx.TransformPoint( v2(0.0,0.0) ), v2(0.5,0.5), 1e-15 );
+  }
+
+  // Otherwise it is copied, as the displacement field of the transform
+  // does not release the buffer to the aligned allocator
+  disImage = sitk::Image( std::vector<unsigned int>(2,5u), sitk::sitkVectorFloat64 );
+  disImage.SetPixelAsVectorFloat64( idx, v2(0.5,0.5) );
+  sitk::ImageBufferAllocator::SetThreadAllocator( SITK_NULLPTR );
+  {
+  sitk::DisplacementFieldTransform tx(disImage);
+  EXPECT_EQ( disImage.GetNumberOfPixels(), 0u );
+  EXPECT_VECTOR_DOUBLE_NEAR( tx.TransformPoint( v2(0.0,0.0) ), v2(0.5,0.5), 1e-15 );
+  EXPECT_VECTOR_DOUBLE_NEAR( tx.TransformPoint( v2(0.5,0.0) ), v2(0.75,0.25), 1e-15 );
+  EXPECT_VECTOR_DOUBLE_NEAR( tx.GetDisplacementField().GetPixelAsVectorFloat64( idx ), v2(0.5,0.5), 1e-15 );
+  }
+}
+
 TEST(TransformTest,Euler2DTransform)
 {
   // test Euler2DTransform
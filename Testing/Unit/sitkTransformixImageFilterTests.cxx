@@ -1,6 +1,7 @@
 #include "SimpleITKTestHarness.h"
 #include "sitkImageFileReader.h"
 #include "sitkCastImageFilter.h"
+#include "sitkHashImageFilter.h"
 #include "sitkElastixImageFilter.h"
 #include "sitkTransformixImageFilter.h"
 
@@ -43,6 +44,229 @@ TEST( TransformixImageFilter, ObjectOrientedInterface )
 }
 
 
+TEST( TransformixImageFilter, NumberOfThreads )
+{
+  Image fixedImage = Cast( ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceBorder20.png" ) ), sitkFloat32 );
+  Image movingImage = Cast( ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceShifted13x17y.png" ) ), sitkFloat32 );
+
+  const unsigned int globalDefaultNumberOfThreads = ProcessObject::GetGlobalDefaultNumberOfThreads();
+
+  ElastixImageFilter silx;
+  silx.SetFixedImage( fixedImage );
+  silx.SetMovingImage( movingImage );
+  silx.SetNumberOfThreads( 2 );
+  silx.Execute();
+
+  TransformixImageFilter stfx;
+  EXPECT_EQ( stfx.GetNumberOfThreads(), globalDefaultNumberOfThreads );
+  EXPECT_NO_THROW( stfx.SetNumberOfThreads( 1 ) );
+  EXPECT_EQ( stfx.GetNumberOfThreads(), 1u );
+  EXPECT_NO_THROW( stfx.SetMovingImage( movingImage ) );
+  EXPECT_NO_THROW( stfx.SetTransformParameterMap( silx.GetTransformParameterMap() ) );
+  EXPECT_NO_THROW( stfx.Execute() );
+  EXPECT_FALSE( stfxIsEmpty( stfx.GetResultImage() ) );
+
+  EXPECT_EQ( ProcessObject::GetGlobalDefaultNumberOfThreads(), globalDefaultNumberOfThreads );
+}
+
+TEST( TransformixImageFilter, PointSet )
+{
+  Image fixedImage = Cast( ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceBorder20.png" ) ), sitkFloat32 );
+  Image movingImage = Cast( ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceShifted13x17y.png" ) ), sitkFloat32 );
+
+  ElastixImageFilter silx;
+  silx.SetFixedImage( fixedImage );
+  silx.SetMovingImage( movingImage );
+  silx.SetParameterMap( "translation" );
+  silx.Execute();
+
+  std::vector< double > fixedPointSet;
+  fixedPointSet.push_back( 100.0 );
+  fixedPointSet.push_back( 100.0 );
+  fixedPointSet.push_back( 120.5 );
+  fixedPointSet.push_back( 80.25 );
+
+  TransformixImageFilter stfx;
+  stfx.SetTransformParameterMap( silx.GetTransformParameterMap() );
+  EXPECT_THROW( stfx.GetResultPointSet(), GenericException );
+  EXPECT_NO_THROW( stfx.SetFixedPointSet( fixedPointSet ) );
+  EXPECT_EQ( stfx.GetFixedPointSet(), fixedPointSet );
+
+  // Points only
+  EXPECT_NO_THROW( stfx.Execute() );
+  std::vector< double > resultPointSet = stfx.GetResultPointSet();
+  ASSERT_EQ( resultPointSet.size(), fixedPointSet.size() );
+
+  // A translation moves both points by the same offset
+  EXPECT_NEAR( resultPointSet[ 0 ] - fixedPointSet[ 0 ], resultPointSet[ 2 ] - fixedPointSet[ 2 ], 1e-3 );
+  EXPECT_NEAR( resultPointSet[ 1 ] - fixedPointSet[ 1 ], resultPointSet[ 3 ] - fixedPointSet[ 3 ], 1e-3 );
+
+  // Points and image
+  EXPECT_NO_THROW( stfx.SetMovingImage( movingImage ) );
+  EXPECT_NO_THROW( stfx.Execute() );
+  EXPECT_FALSE( stfxIsEmpty( stfx.GetResultImage() ) );
+  EXPECT_EQ( stfx.GetResultPointSet().size(), fixedPointSet.size() );
+
+  // Coordinates must be a multiple of the dimension
+  fixedPointSet.push_back( 1.0 );
+  stfx.SetFixedPointSet( fixedPointSet );
+  EXPECT_THROW( stfx.Execute(), GenericException );
+}
+
+TEST( TransformixImageFilter, VectorOfMovingImages )
+{
+  Image fixedImage = Cast( ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceBorder20.png" ) ), sitkFloat32 );
+  Image movingImage = Cast( ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceShifted13x17y.png" ) ), sitkFloat32 );
+  Image movingLabelImage = ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceBorder20Mask.png" ) );
+
+  ElastixImageFilter silx;
+  silx.SetFixedImage( fixedImage );
+  silx.SetMovingImage( movingImage );
+  silx.SetParameterMap( "translation" );
+  silx.Execute();
+
+  TransformixImageFilter::VectorOfImage movingImages;
+  movingImages.push_back( movingImage );
+  movingImages.push_back( movingLabelImage );
+  movingImages.push_back( movingImage );
+
+  TransformixImageFilter stfx;
+  stfx.SetTransformParameterMap( silx.GetTransformParameterMap() );
+  stfx.ComputeDeformationFieldOn();
+  EXPECT_THROW( stfx.Execute( TransformixImageFilter::VectorOfImage() ), GenericException );
+
+  TransformixImageFilter::VectorOfImage resultImages;
+  EXPECT_NO_THROW( resultImages = stfx.Execute( movingImages ) );
+  ASSERT_EQ( resultImages.size(), movingImages.size() );
+  for( unsigned int i = 0; i < resultImages.size(); ++i )
+  {
+    EXPECT_FALSE( stfxIsEmpty( resultImages[ i ] ) );
+  }
+
+  // Same transform, same image, same result
+  EXPECT_EQ( Hash( resultImages[ 0 ] ), Hash( resultImages[ 2 ] ) );
+
+  // Settings are restored and the deformation field is computed once
+  EXPECT_TRUE( stfx.GetComputeDeformationField() );
+  EXPECT_FALSE( stfxIsEmpty( stfx.GetDeformationField() ) );
+  EXPECT_TRUE( stfxIsEmpty( stfx.GetMovingImage() ) );
+}
+
+TEST( TransformixImageFilter, DeformationFieldAndSpatialJacobian )
+{
+  Image fixedImage = Cast( ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceBorder20.png" ) ), sitkFloat32 );
+  Image movingImage = Cast( ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceShifted13x17y.png" ) ), sitkFloat32 );
+
+  ElastixImageFilter silx;
+  silx.SetFixedImage( fixedImage );
+  silx.SetMovingImage( movingImage );
+  silx.SetParameterMap( "translation" );
+  silx.Execute();
+
+  TransformixImageFilter stfx;
+  stfx.SetMovingImage( movingImage );
+  stfx.SetTransformParameterMap( silx.GetTransformParameterMap() );
+  EXPECT_NO_THROW( stfx.Execute() );
+  EXPECT_THROW( stfx.GetDeformationField(), GenericException );
+  EXPECT_THROW( stfx.GetSpatialJacobian(), GenericException );
+  EXPECT_THROW( stfx.GetDeterminantOfSpatialJacobian(), GenericException );
+
+  stfx.ComputeDeformationFieldOn();
+  stfx.ComputeSpatialJacobianOn();
+  stfx.ComputeDeterminantOfSpatialJacobianOn();
+  EXPECT_NO_THROW( stfx.Execute() );
+
+  Image deformationField = stfx.GetDeformationField();
+  EXPECT_EQ( deformationField.GetSize(), fixedImage.GetSize() );
+  EXPECT_EQ( deformationField.GetNumberOfComponentsPerPixel(), 2u );
+
+  Image spatialJacobian = stfx.GetSpatialJacobian();
+  EXPECT_EQ( spatialJacobian.GetSize(), fixedImage.GetSize() );
+  EXPECT_EQ( spatialJacobian.GetNumberOfComponentsPerPixel(), 4u );
+
+  // A translation does not change volume
+  Image determinantOfSpatialJacobian = stfx.GetDeterminantOfSpatialJacobian();
+  EXPECT_EQ( determinantOfSpatialJacobian.GetSize(), fixedImage.GetSize() );
+  EXPECT_EQ( determinantOfSpatialJacobian.GetPixelID(), sitkFloat32 );
+  std::vector< unsigned int > index( 2, 50u );
+  EXPECT_NEAR( determinantOfSpatialJacobian.GetPixelAsFloat( index ), 1.0, 1e-3 );
+}
+
+TEST( TransformixImageFilter, ExecuteAsync )
+{
+  Image fixedImage = Cast( ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceBorder20.png" ) ), sitkFloat32 );
+  Image movingImage = Cast( ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceShifted13x17y.png" ) ), sitkFloat32 );
+
+  ElastixImageFilter silx;
+  silx.SetFixedImage( fixedImage );
+  silx.SetMovingImage( movingImage );
+  silx.SetParameterMap( "translation" );
+  silx.Execute();
+
+  TransformixImageFilter stfx;
+  stfx.SetMovingImage( movingImage );
+  stfx.SetTransformParameterMap( silx.GetTransformParameterMap() );
+  Image resultImage = stfx.Execute();
+
+  EXPECT_NO_THROW( stfx.ExecuteAsync() );
+  Image asyncResultImage;
+  EXPECT_NO_THROW( asyncResultImage = stfx.Wait() );
+  EXPECT_TRUE( stfx.IsDone() );
+  EXPECT_EQ( Hash( resultImage ), Hash( asyncResultImage ) );
+}
+
+TEST( TransformixImageFilter, ResultImageFileName )
+{
+  Image fixedImage = Cast( ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceBorder20.png" ) ), sitkFloat32 );
+  Image movingImage = Cast( ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceShifted13x17y.png" ) ), sitkFloat32 );
+  const std::string resultImageFileName = dataFinder.GetOutputFile( "TransformixImageFilter.ResultImageFileName.mha" );
+
+  ElastixImageFilter silx;
+  silx.SetFixedImage( fixedImage );
+  silx.SetMovingImage( movingImage );
+  silx.SetParameterMap( "translation" );
+  silx.Execute();
+
+  TransformixImageFilter stfx;
+  EXPECT_EQ( stfx.GetNumberOfStreamDivisions(), 16u );
+  EXPECT_THROW( stfx.SetNumberOfStreamDivisions( 0 ), GenericException );
+  stfx.SetMovingImage( movingImage );
+  stfx.SetTransformParameterMap( silx.GetTransformParameterMap() );
+  Image resultImage = stfx.Execute();
+
+  // Slabs are resampled exactly as the whole image
+  EXPECT_NO_THROW( stfx.SetResultImageFileName( resultImageFileName ) );
+  EXPECT_NO_THROW( stfx.SetNumberOfStreamDivisions( 7 ) );
+  EXPECT_NO_THROW( stfx.Execute() );
+  EXPECT_THROW( stfx.GetResultImage(), GenericException );
+  EXPECT_EQ( Hash( ReadImage( resultImageFileName ) ), Hash( resultImage ) );
+
+  EXPECT_NO_THROW( stfx.ComputeDeformationFieldOn() );
+  EXPECT_THROW( stfx.Execute(), GenericException );
+}
+
+TEST( TransformixImageFilter, MoveResultImage )
+{
+  Image fixedImage = Cast( ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceBorder20.png" ) ), sitkFloat32 );
+  Image movingImage = Cast( ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceShifted13x17y.png" ) ), sitkFloat32 );
+
+  ElastixImageFilter silx;
+  silx.SetFixedImage( fixedImage );
+  silx.SetMovingImage( movingImage );
+  silx.SetParameterMap( "translation" );
+  silx.Execute();
+
+  TransformixImageFilter stfx;
+  stfx.SetMovingImage( movingImage );
+  stfx.SetTransformParameterMap( silx.GetTransformParameterMap() );
+  EXPECT_NO_THROW( stfx.Execute() );
+
+  Image resultImage;
+  EXPECT_NO_THROW( resultImage = stfx.MoveResultImage() );
+  EXPECT_FALSE( stfxIsEmpty( resultImage ) );
+  EXPECT_THROW( stfx.GetResultImage(), GenericException );
+}
+
 TEST( TransformixImageFilter, ProceduralInterface )
 {
   Image fixedImage = Cast( ReadImage( dataFinder.GetFile( "Input/BrainProtonDensitySliceBorder20.png" ) ), sitkFloat32 );
@@ -69,6 +69,26 @@
 %ignore itk::simple::Image::GetBufferAsUInt64;
 %ignore itk::simple::Image::GetBufferAsFloat;
 %ignore itk::simple::Image::GetBufferAsDouble;
+%ignore itk::simple::Image::GetRegionAsInt8;
+%ignore itk::simple::Image::GetRegionAsUInt8;
+%ignore itk::simple::Image::GetRegionAsInt16;
+%ignore itk::simple::Image::GetRegionAsUInt16;
+%ignore itk::simple::Image::GetRegionAsInt32;
+%ignore itk::simple::Image::GetRegionAsUInt32;
+%ignore itk::simple::Image::GetRegionAsInt64;
+%ignore itk::simple::Image::GetRegionAsUInt64;
+%ignore itk::simple::Image::GetRegionAsFloat;
+%ignore itk::simple::Image::GetRegionAsDouble;
+%ignore itk::simple::Image::SetRegionAsInt8;
+%ignore itk::simple::Image::SetRegionAsUInt8;
+%ignore itk::simple::Image::SetRegionAsInt16;
+%ignore itk::simple::Image::SetRegionAsUInt16;
+%ignore itk::simple::Image::SetRegionAsInt32;
+%ignore itk::simple::Image::SetRegionAsUInt32;
+%ignore itk::simple::Image::SetRegionAsInt64;
+%ignore itk::simple::Image::SetRegionAsUInt64;
+%ignore itk::simple::Image::SetRegionAsFloat;
+%ignore itk::simple::Image::SetRegionAsDouble;
 #endif
 
 
@@ -205,6 +225,8 @@ namespace std
 // SimpleElastix
 %template( ParameterMap ) std::map< std::string, std::vector< std::string > >;
 %template( VectorOfParameterMap ) std::vector< std::map< std::string, std::vector< std::string > > >;
+%template( VectorOfVectorOfParameterMap ) std::vector< std::vector< std::map< std::string, std::vector< std::string > > > >;
+%template( IterationInfo ) std::map< std::string, std::vector< double > >;
 %include "sitkElastixImageFilter.h"
 %include "sitkTransformixImageFilter.h"
 
@@ -605,6 +605,7 @@
 // Numpy array conversion support
 %native(_GetMemoryViewFromImage) PyObject *sitk_GetMemoryViewFromImage( PyObject *self, PyObject *args );
 %native(_SetImageFromArray) PyObject *sitk_SetImageFromArray( PyObject *self, PyObject *args );
+%native(_SetImageRegionFromArray) PyObject *sitk_SetImageRegionFromArray( PyObject *self, PyObject *args );
 
 %pythoncode %{
 
@@ -718,6 +719,8 @@ def GetArrayViewFromImage(image):
 
     Returns a Numpy ndarray object as a "view" of the SimpleITK's Image buffer. This reduces pixel buffer copies, but requires that the SimpleITK image object is kept around while the buffer is being used.
 
+    For an image which is not fully buffered the array holds only the buffered region.
+
 
     """
 
@@ -730,7 +733,7 @@ def GetArrayViewFromImage(image):
 
     dtype = _get_numpy_dtype( image )
 
-    shape = image.GetSize();
+    shape = image.GetBufferedSize();
     if image.GetNumberOfComponentsPerPixel() > 1:
       shape = ( image.GetNumberOfComponentsPerPixel(), ) + shape
 
@@ -742,6 +745,37 @@ def GetArrayViewFromImage(image):
 
     return arrayView
 
+def GetArrayViewFromImageRegion(image, index, size):
+    """Get a NumPy ndarray view of a region of a SimpleITK Image.
+
+    The region starts at index and has size pixels along each dimension, both in the order of the image's dimensions. No pixels are copied, so as with GetArrayViewFromImage the SimpleITK image object must be kept around while the view is being used.
+    """
+
+    start = [ i - b for i, b in zip( index, image.GetBufferedIndex() ) ]
+    for s, n, b in zip( start, size, image.GetBufferedSize() ):
+      if s < 0 or s + n > b:
+        raise IndexError( "The region is outside of the buffered region of the image." )
+
+    arrayView = GetArrayViewFromImage(image)
+    return arrayView[ tuple( slice( s, s + n ) for s, n in zip( start, size ) )[::-1] ]
+
+def SetImageRegionFromArray(image, arr, index):
+    """Copy a NumPy ndarray into the region of a SimpleITK Image starting at index.
+
+    The array has the shape of the region, as returned by GetArrayViewFromImageRegion, and is converted to the pixel type of the image. The image is modified in place with a single copy of each line of the region.
+    """
+
+    if not HAVE_NUMPY:
+        raise ImportError('Numpy not available.')
+
+    z = numpy.ascontiguousarray( arr, dtype = _get_numpy_dtype( image ) )
+
+    shape = z.shape
+    if image.GetNumberOfComponentsPerPixel() > 1:
+      shape = shape[:-1]
+
+    _SimpleITK._SetImageRegionFromArray( z, image, index, shape[::-1] )
+
 def GetArrayFromImage(image):
     """Get a NumPy ndarray from a SimpleITK Image.
 
@@ -766,12 +800,13 @@ def GetImageFromArray( arr, isVector=False):
     assert z.ndim in ( 2, 3, 4 ), \
       "Only arrays of 2, 3 or 4 dimensions are supported."
 
+    # the buffer is completely overwritten with the array
     if ( z.ndim == 3 and isVector ) or (z.ndim == 4):
       id = _get_sitk_vector_pixelid( z )
-      img = Image( z.shape[-2::-1] , id, z.shape[-1] )
+      img = Image( z.shape[-2::-1] , id, z.shape[-1], sitkUninitialized )
     elif z.ndim in ( 2, 3 ):
       id = _get_sitk_pixelid( z )
-      img = Image( z.shape[::-1], id )
+      img = Image( z.shape[::-1], id, 0, sitkUninitialized )
 
     _SimpleITK._SetImageFromArray( z.tostring(), img )
 
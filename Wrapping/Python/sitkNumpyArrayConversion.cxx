@@ -26,6 +26,60 @@
 
 namespace sitk = itk::simple;
 
+/** Converts a python sequence of integers to an index or size. */
+static bool
+sitk_SequenceToVector( PyObject *sequence, std::vector< uint32_t > &out )
+{
+  PyObject *fast = PySequence_Fast( sequence, "A sequence of integers is required." );
+  if ( fast == NULL )
+    {
+    return false;
+    }
+
+  out.resize( PySequence_Fast_GET_SIZE( fast ) );
+  for ( size_t i = 0; i < out.size(); ++i )
+    {
+    const Py_ssize_t value = PyNumber_AsSsize_t( PySequence_Fast_GET_ITEM( fast, i ), NULL );
+    if ( value < 0 )
+      {
+      Py_DECREF( fast );
+      if ( !PyErr_Occurred() )
+        {
+        PyErr_SetString( PyExc_ValueError, "A sequence of non-negative integers is required." );
+        }
+      return false;
+      }
+    out[i] = static_cast< uint32_t >( value );
+    }
+
+  Py_DECREF( fast );
+  return true;
+}
+
+/** Copies a buffer of the pixel component type into a region of the image. */
+template< typename TBufferType >
+static bool
+sitk_SetImageRegionFromBuffer( sitk::Image *sitkImage,
+                               const std::vector< uint32_t > &index,
+                               const std::vector< uint32_t > &size,
+                               const Py_buffer &pyBuffer,
+                               void (sitk::Image::*setRegion)( const std::vector< uint32_t > &,
+                                                               const std::vector< uint32_t > &,
+                                                               const TBufferType * ) )
+{
+  size_t len = std::accumulate( size.begin(), size.end(), size_t(1), std::multiplies<size_t>() );
+  len *= sitkImage->GetNumberOfComponentsPerPixel() * sizeof( TBufferType );
+
+  if ( static_cast< size_t >( pyBuffer.len ) != len )
+    {
+    PyErr_SetString( PyExc_RuntimeError, "Size mismatch of image region and Buffer." );
+    return false;
+    }
+
+  (sitkImage->*setRegion)( index, size, static_cast< const TBufferType * >( pyBuffer.buf ) );
+  return true;
+}
+
 // Python is written in C
 #ifdef __cplusplus
 extern "C"
@@ -135,7 +189,7 @@ sitk_GetMemoryViewFromImage( PyObject *SWIGUNUSEDPARM(self), PyObject *args )
     }
 
   dimension = sitkImage->GetDimension();
-  size = sitkImage->GetSize();
+  size = sitkImage->GetBufferedSize();
 
   // if the image is a vector just treat is as another dimension
   if ( sitkImage->GetNumberOfComponentsPerPixel() > 1 )
@@ -306,7 +360,7 @@ sitk_SetImageFromArray( PyObject *SWIGUNUSEDPARM(self), PyObject *args )
 
 
   dimension = sitkImage->GetDimension();
-  size = sitkImage->GetSize();
+  size = sitkImage->GetBufferedSize();
 
   // if the image is a vector just treat is as another dimension
   if ( sitkImage->GetNumberOfComponentsPerPixel() > 1 )
@@ -334,6 +388,123 @@ fail:
   return NULL;
 }
 
+/** An internal function that copies a C contiguous buffer into a
+ * region of the image, given by the index and size of the region.
+ */
+static PyObject*
+sitk_SetImageRegionFromArray( PyObject *SWIGUNUSEDPARM(self), PyObject *args )
+{
+  PyObject * pyImage = NULL;
+  PyObject * pyIndex = NULL;
+  PyObject * pySize = NULL;
+
+  Py_buffer  pyBuffer;
+  memset(&pyBuffer, 0, sizeof(Py_buffer));
+
+  sitk::Image * sitkImage = NULL;
+  std::vector< uint32_t > index;
+  std::vector< uint32_t > size;
+  bool copied = false;
+
+  if ( !PyArg_ParseTuple( args, "s*OOO", &pyBuffer, &pyImage, &pyIndex, &pySize ) )
+    {
+    return NULL;
+    }
+
+  if ( PyBuffer_IsContiguous( &pyBuffer, 'C' ) != 1 )
+    {
+    PyBuffer_Release( &pyBuffer );
+    PyErr_SetString( PyExc_TypeError, "A C Contiguous buffer object is required." );
+    return NULL;
+    }
+
+  /* Cast over to a sitk Image. */
+  {
+    void * voidImage;
+    int res = 0;
+    res = SWIG_ConvertPtr( pyImage, &voidImage, SWIGTYPE_p_itk__simple__Image, 0 );
+    if( !SWIG_IsOK( res ) )
+      {
+      SWIG_exception_fail(SWIG_ArgError(res), "in method 'SetImageRegionFromArray', argument needs to be of type 'sitk::Image *'");
+      }
+    sitkImage = reinterpret_cast< sitk::Image * >( voidImage );
+  }
+
+  if ( !sitk_SequenceToVector( pyIndex, index ) || !sitk_SequenceToVector( pySize, size ) )
+    {
+    goto fail;
+    }
+
+  try
+    {
+    switch( sitkImage->GetPixelIDValue() )
+      {
+      case sitk::ConditionalValue< sitk::sitkVectorUInt8 != sitk::sitkUnknown, sitk::sitkVectorUInt8, -14 >::Value:
+      case sitk::ConditionalValue< sitk::sitkUInt8 != sitk::sitkUnknown, sitk::sitkUInt8, -2 >::Value:
+        copied = sitk_SetImageRegionFromBuffer< uint8_t >( sitkImage, index, size, pyBuffer, &sitk::Image::SetRegionAsUInt8 );
+        break;
+      case sitk::ConditionalValue< sitk::sitkVectorInt8 != sitk::sitkUnknown, sitk::sitkVectorInt8, -15 >::Value:
+      case sitk::ConditionalValue< sitk::sitkInt8 != sitk::sitkUnknown, sitk::sitkInt8, -3 >::Value:
+        copied = sitk_SetImageRegionFromBuffer< int8_t >( sitkImage, index, size, pyBuffer, &sitk::Image::SetRegionAsInt8 );
+        break;
+      case sitk::ConditionalValue< sitk::sitkVectorUInt16 != sitk::sitkUnknown, sitk::sitkVectorUInt16, -16 >::Value:
+      case sitk::ConditionalValue< sitk::sitkUInt16 != sitk::sitkUnknown, sitk::sitkUInt16, -4 >::Value:
+        copied = sitk_SetImageRegionFromBuffer< uint16_t >( sitkImage, index, size, pyBuffer, &sitk::Image::SetRegionAsUInt16 );
+        break;
+      case sitk::ConditionalValue< sitk::sitkVectorInt16 != sitk::sitkUnknown, sitk::sitkVectorInt16, -17 >::Value:
+      case sitk::ConditionalValue< sitk::sitkInt16 != sitk::sitkUnknown, sitk::sitkInt16, -5 >::Value:
+        copied = sitk_SetImageRegionFromBuffer< int16_t >( sitkImage, index, size, pyBuffer, &sitk::Image::SetRegionAsInt16 );
+        break;
+      case sitk::ConditionalValue< sitk::sitkVectorUInt32 != sitk::sitkUnknown, sitk::sitkVectorUInt32, -18 >::Value:
+      case sitk::ConditionalValue< sitk::sitkUInt32 != sitk::sitkUnknown, sitk::sitkUInt32, -6 >::Value:
+        copied = sitk_SetImageRegionFromBuffer< uint32_t >( sitkImage, index, size, pyBuffer, &sitk::Image::SetRegionAsUInt32 );
+        break;
+      case sitk::ConditionalValue< sitk::sitkVectorInt32 != sitk::sitkUnknown, sitk::sitkVectorInt32, -19 >::Value:
+      case sitk::ConditionalValue< sitk::sitkInt32 != sitk::sitkUnknown, sitk::sitkInt32, -7 >::Value:
+        copied = sitk_SetImageRegionFromBuffer< int32_t >( sitkImage, index, size, pyBuffer, &sitk::Image::SetRegionAsInt32 );
+        break;
+      case sitk::ConditionalValue< sitk::sitkVectorUInt64 != sitk::sitkUnknown, sitk::sitkVectorUInt64, -20 >::Value:
+      case sitk::ConditionalValue< sitk::sitkUInt64 != sitk::sitkUnknown, sitk::sitkUInt64, -8 >::Value:
+        copied = sitk_SetImageRegionFromBuffer< uint64_t >( sitkImage, index, size, pyBuffer, &sitk::Image::SetRegionAsUInt64 );
+        break;
+      case sitk::ConditionalValue< sitk::sitkVectorInt64 != sitk::sitkUnknown, sitk::sitkVectorInt64, -21 >::Value:
+      case sitk::ConditionalValue< sitk::sitkInt64 != sitk::sitkUnknown, sitk::sitkInt64, -9 >::Value:
+        copied = sitk_SetImageRegionFromBuffer< int64_t >( sitkImage, index, size, pyBuffer, &sitk::Image::SetRegionAsInt64 );
+        break;
+      case sitk::ConditionalValue< sitk::sitkVectorFloat32 != sitk::sitkUnknown, sitk::sitkVectorFloat32, -22 >::Value:
+      case sitk::ConditionalValue< sitk::sitkFloat32 != sitk::sitkUnknown, sitk::sitkFloat32, -10 >::Value:
+        copied = sitk_SetImageRegionFromBuffer< float >( sitkImage, index, size, pyBuffer, &sitk::Image::SetRegionAsFloat );
+        break;
+      case sitk::ConditionalValue< sitk::sitkVectorFloat64 != sitk::sitkUnknown, sitk::sitkVectorFloat64, -23 >::Value:
+      case sitk::ConditionalValue< sitk::sitkFloat64 != sitk::sitkUnknown, sitk::sitkFloat64, -11 >::Value:
+        copied = sitk_SetImageRegionFromBuffer< double >( sitkImage, index, size, pyBuffer, &sitk::Image::SetRegionAsDouble );
+        break;
+      default:
+        PyErr_SetString( PyExc_RuntimeError, "Images of this pixel type are not supported." );
+        goto fail;
+      }
+    }
+  catch( const std::exception &e )
+    {
+    std::string msg = "Exception thrown in SimpleITK SetImageRegionFromArray: ";
+    msg += e.what();
+    PyErr_SetString( PyExc_RuntimeError, msg.c_str() );
+    goto fail;
+    }
+
+  if ( !copied )
+    {
+    goto fail;
+    }
+
+  PyBuffer_Release( &pyBuffer );
+  Py_RETURN_NONE;
+
+fail:
+  PyBuffer_Release( &pyBuffer );
+  return NULL;
+}
+
 #ifdef __cplusplus
 } // end extern "C"
 #endif